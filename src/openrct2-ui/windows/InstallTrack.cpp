@@ -163,6 +163,7 @@ static void window_install_track_close(rct_window *w)
     SafeFree(_trackDesignPreviewPixels);
     track_design_dispose(_trackDesign);
     _trackDesign = nullptr;
+    track_design_preview_dispose();
 }
 
 /**
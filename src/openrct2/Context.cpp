@@ -40,6 +40,7 @@
 #include "ParkImporter.h"
 #include "platform/crash.h"
 #include "PlatformEnvironment.h"
+#include "Profiler.h"
 #include "ride/TrackDesignRepository.h"
 #include "scenario/ScenarioRepository.h"
 #include "title/TitleScreen.h"
@@ -65,6 +66,7 @@
 #include "platform/platform.h"
 #include "rct1.h"
 #include "rct2/interop.h"
+#include "scenario/scenario.h"
 #include "util/util.h"
 
 using namespace OpenRCT2;
@@ -117,6 +119,8 @@ namespace OpenRCT2
 
         ~Context() override
         {
+            scenario_autosave_wait();
+            profiler_write_output();
             network_close();
             http_dispose();
             language_close_all();
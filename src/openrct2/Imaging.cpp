@@ -129,10 +129,16 @@ namespace Imaging
 
     bool PngWrite(const rct_drawpixelinfo * dpi, const rct_palette * palette, const utf8 * path)
     {
-        bool result = false;
-
-        // Get image size
         int stride = dpi->width + dpi->pitch;
+        return PngWriteRows(dpi->width, dpi->height, palette, path, [dpi, stride](sint32 y) -> const uint8 *
+        {
+            return dpi->bits + (y * stride);
+        });
+    }
+
+    bool PngWriteRows(sint32 width, sint32 height, const rct_palette * palette, const utf8 * path, const PngRowCallback &getRow)
+    {
+        bool result = false;
 
         // Setup PNG
         png_structp png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
@@ -173,19 +179,22 @@ namespace Imaging
 
             // Write header
             png_set_IHDR(
-                png_ptr, info_ptr, dpi->width, dpi->height, 8,
+                png_ptr, info_ptr, width, height, 8,
                 PNG_COLOR_TYPE_PALETTE, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT
             );
             png_byte transparentIndex = 0;
             png_set_tRNS(png_ptr, info_ptr, &transparentIndex, 1, nullptr);
             png_write_info(png_ptr, info_ptr);
 
-            // Write pixels
-            uint8 * bits = dpi->bits;
-            for (int y = 0; y < dpi->height; y++)
+            // Write pixels, one row at a time so the caller never has to hold the whole image
+            for (sint32 y = 0; y < height; y++)
             {
+                const uint8 * bits = getRow(y);
+                if (bits == nullptr)
+                {
+                    throw Exception("PNG row not available");
+                }
                 png_write_row(png_ptr, (png_byte *)bits);
-                bits += stride;
             }
 
             // Finish
@@ -22,10 +22,19 @@
 
 #ifdef __cplusplus
 
+#include <functional>
+
 namespace Imaging
 {
+    /**
+     * Returns the pixels of row y of the image being written. Rows are requested in order, and the returned
+     * pointer only needs to stay valid until the next row is requested. Returning nullptr aborts the write.
+     */
+    using PngRowCallback = std::function<const uint8 *(sint32 y)>;
+
     bool PngRead(uint8 * * pixels, uint32 * width, uint32 * height, const utf8 * path);
     bool PngWrite(const rct_drawpixelinfo * dpi, const rct_palette * palette, const utf8 * path);
+    bool PngWriteRows(sint32 width, sint32 height, const rct_palette * palette, const utf8 * path, const PngRowCallback &getRow);
     bool PngWrite32bpp(sint32 width, sint32 height, const void * pixels, const utf8 * path);
 }
 
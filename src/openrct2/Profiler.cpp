@@ -0,0 +1,322 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+
+#include <chrono>
+#include <string>
+#include "core/Console.hpp"
+#include "core/Exception.hpp"
+#include "core/FileStream.hpp"
+#include "core/Json.hpp"
+#include "core/Math.hpp"
+#include "core/Path.hpp"
+#include "core/String.hpp"
+#include "game.h"
+#include "Profiler.h"
+
+using profiler_clock = std::chrono::high_resolution_clock;
+
+static const utf8 * PhaseNames[PROFILER_PHASE_COUNT] =
+{
+    "network",
+    "scenario",
+    "climate",
+    "map_tiles",
+    "path_wide_flags",
+    "peeps",
+    "vehicles",
+    "misc_sprites",
+    "rides",
+    "park",
+    "research",
+    "ride_ratings",
+    "ride_measurements",
+    "news",
+    "map_animations",
+    "sounds",
+    "other",
+};
+
+struct ProfilerTick
+{
+    uint32 Tick;
+    uint64 Nanoseconds[PROFILER_PHASE_COUNT];
+};
+
+static bool                         _enabled = false;
+static bool                         _inTick = false;
+static std::string                  _outputPath;
+static profiler_clock::time_point   _lapStart;
+static ProfilerTick                 _currentTick;
+static uint64                       _phaseCalls[PROFILER_PHASE_COUNT];
+static uint64                       _phaseTotals[PROFILER_PHASE_COUNT];
+
+// Ring buffer of the most recent ticks, _tickCount % PROFILER_HISTORY_SIZE is the next slot to be written
+static ProfilerTick                 _history[PROFILER_HISTORY_SIZE];
+static uint64                       _tickCount = 0;
+
+static double profiler_ns_to_ms(uint64 ns)
+{
+    return ns / 1000000.0;
+}
+
+static size_t profiler_get_history_size()
+{
+    return (size_t)Math::Min<uint64>(_tickCount, PROFILER_HISTORY_SIZE);
+}
+
+/**
+ * Gets the index'th tick of the history, where 0 is the oldest tick still held.
+ */
+static const ProfilerTick * profiler_get_history_tick(size_t index)
+{
+    size_t historySize = profiler_get_history_size();
+    size_t oldest = (size_t)((_tickCount - historySize) % PROFILER_HISTORY_SIZE);
+    return &_history[(oldest + index) % PROFILER_HISTORY_SIZE];
+}
+
+static uint64 profiler_get_tick_total(const ProfilerTick * tick)
+{
+    uint64 total = 0;
+    for (sint32 i = 0; i < PROFILER_PHASE_COUNT; i++)
+    {
+        total += tick->Nanoseconds[i];
+    }
+    return total;
+}
+
+static bool profiler_write_csv(const utf8 * path)
+{
+    std::string csv = "tick";
+    for (sint32 i = 0; i < PROFILER_PHASE_COUNT; i++)
+    {
+        csv += ",";
+        csv += PhaseNames[i];
+    }
+    csv += ",total\n";
+
+    // One row per tick, times are in microseconds
+    size_t historySize = profiler_get_history_size();
+    for (size_t i = 0; i < historySize; i++)
+    {
+        const ProfilerTick * tick = profiler_get_history_tick(i);
+        csv += String::StdFormat("%u", tick->Tick);
+        for (sint32 j = 0; j < PROFILER_PHASE_COUNT; j++)
+        {
+            csv += String::StdFormat(",%.3f", tick->Nanoseconds[j] / 1000.0);
+        }
+        csv += String::StdFormat(",%.3f\n", profiler_get_tick_total(tick) / 1000.0);
+    }
+
+    try
+    {
+        auto fs = FileStream(path, FILE_MODE_WRITE);
+        fs.Write(csv.c_str(), csv.size());
+        return true;
+    }
+    catch (const Exception &)
+    {
+        return false;
+    }
+}
+
+static bool profiler_write_json(const utf8 * path)
+{
+    json_t * jsonPhases = json_array();
+    for (sint32 i = 0; i < PROFILER_PHASE_COUNT; i++)
+    {
+        profiler_phase_summary summary;
+        profiler_get_phase_summary((PROFILER_PHASE)i, &summary);
+
+        json_t * jsonPhase = json_object();
+        json_object_set_new(jsonPhase, "name", json_string(PhaseNames[i]));
+        json_object_set_new(jsonPhase, "calls", json_integer((json_int_t)summary.calls));
+        json_object_set_new(jsonPhase, "total_ms", json_real(summary.total_ms));
+        json_object_set_new(jsonPhase, "average_ms", json_real(summary.average_ms));
+        json_object_set_new(jsonPhase, "max_ms", json_real(summary.max_ms));
+        json_array_append_new(jsonPhases, jsonPhase);
+    }
+
+    // Per tick times are in microseconds, in the same order as the phases
+    json_t * jsonHistory = json_array();
+    size_t historySize = profiler_get_history_size();
+    for (size_t i = 0; i < historySize; i++)
+    {
+        const ProfilerTick * tick = profiler_get_history_tick(i);
+        json_t * jsonTimes = json_array();
+        for (sint32 j = 0; j < PROFILER_PHASE_COUNT; j++)
+        {
+            json_array_append_new(jsonTimes, json_real(tick->Nanoseconds[j] / 1000.0));
+        }
+
+        json_t * jsonTick = json_object();
+        json_object_set_new(jsonTick, "tick", json_integer(tick->Tick));
+        json_object_set_new(jsonTick, "us", jsonTimes);
+        json_array_append_new(jsonHistory, jsonTick);
+    }
+
+    json_t * jsonProfile = json_object();
+    json_object_set_new(jsonProfile, "ticks", json_integer((json_int_t)_tickCount));
+    json_object_set_new(jsonProfile, "phases", jsonPhases);
+    json_object_set_new(jsonProfile, "history", jsonHistory);
+
+    bool result = true;
+    try
+    {
+        Json::WriteToFile(path, jsonProfile, JSON_INDENT(4) | JSON_PRESERVE_ORDER);
+    }
+    catch (const Exception &)
+    {
+        result = false;
+    }
+    json_decref(jsonProfile);
+    return result;
+}
+
+extern "C"
+{
+    bool profiler_is_enabled()
+    {
+        return _enabled;
+    }
+
+    void profiler_set_enabled(bool enabled)
+    {
+        _enabled = enabled;
+        _inTick = false;
+    }
+
+    void profiler_reset()
+    {
+        _inTick = false;
+        _tickCount = 0;
+        for (sint32 i = 0; i < PROFILER_PHASE_COUNT; i++)
+        {
+            _phaseCalls[i] = 0;
+            _phaseTotals[i] = 0;
+        }
+    }
+
+    void profiler_tick_begin()
+    {
+        if (!_enabled)
+        {
+            return;
+        }
+
+        _inTick = true;
+        _currentTick = { 0 };
+        _currentTick.Tick = gCurrentTicks;
+        _lapStart = profiler_clock::now();
+    }
+
+    /**
+     * Attributes the time since the tick began, or since the previous phase ended, to the given phase.
+     */
+    void profiler_phase_end(PROFILER_PHASE phase)
+    {
+        if (!_inTick)
+        {
+            return;
+        }
+
+        auto now = profiler_clock::now();
+        uint64 ns = (uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(now - _lapStart).count();
+        _currentTick.Nanoseconds[phase] += ns;
+        _phaseTotals[phase] += ns;
+        _phaseCalls[phase]++;
+        _lapStart = now;
+    }
+
+    void profiler_tick_end()
+    {
+        if (!_inTick)
+        {
+            return;
+        }
+
+        profiler_phase_end(PROFILER_PHASE_OTHER);
+        _history[_tickCount % PROFILER_HISTORY_SIZE] = _currentTick;
+        _tickCount++;
+        _inTick = false;
+    }
+
+    const utf8 * profiler_get_phase_name(PROFILER_PHASE phase)
+    {
+        return PhaseNames[phase];
+    }
+
+    uint64 profiler_get_tick_count()
+    {
+        return _tickCount;
+    }
+
+    void profiler_get_phase_summary(PROFILER_PHASE phase, profiler_phase_summary * summary)
+    {
+        uint64 historyTotal = 0;
+        uint64 historyMax = 0;
+        size_t historySize = profiler_get_history_size();
+        for (size_t i = 0; i < historySize; i++)
+        {
+            uint64 ns = profiler_get_history_tick(i)->Nanoseconds[phase];
+            historyTotal += ns;
+            historyMax = Math::Max(historyMax, ns);
+        }
+
+        summary->calls = _phaseCalls[phase];
+        summary->total_ms = profiler_ns_to_ms(_phaseTotals[phase]);
+        summary->average_ms = historySize == 0 ? 0 : profiler_ns_to_ms(historyTotal) / historySize;
+        summary->max_ms = profiler_ns_to_ms(historyMax);
+    }
+
+    /**
+     * Writes the recorded timings to a JSON file if the path ends with .json, otherwise to a CSV file.
+     */
+    bool profiler_write(const utf8 * path)
+    {
+        if (String::Equals(Path::GetExtension(path), ".json", true))
+        {
+            return profiler_write_json(path);
+        }
+        return profiler_write_csv(path);
+    }
+
+    /**
+     * Enables the profiler and sets where the timings are written to when the context is disposed.
+     */
+    void profiler_set_output_path(const utf8 * path)
+    {
+        _outputPath = path;
+        profiler_set_enabled(true);
+    }
+
+    void profiler_write_output()
+    {
+        if (_outputPath.empty())
+        {
+            return;
+        }
+
+        if (profiler_write(_outputPath.c_str()))
+        {
+            Console::WriteLine("Profile written to '%s'.", _outputPath.c_str());
+        }
+        else
+        {
+            Console::Error::WriteLine("Unable to write profile to '%s'.", _outputPath.c_str());
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include "common.h"
+
+// Number of most recent game ticks kept for the per tick history
+#define PROFILER_HISTORY_SIZE 512
+
+typedef enum PROFILER_PHASE
+{
+    PROFILER_PHASE_NETWORK,
+    PROFILER_PHASE_SCENARIO,
+    PROFILER_PHASE_CLIMATE,
+    PROFILER_PHASE_MAP_TILES,
+    PROFILER_PHASE_PATH_WIDE_FLAGS,
+    PROFILER_PHASE_PEEPS,
+    PROFILER_PHASE_VEHICLES,
+    PROFILER_PHASE_MISC_SPRITES,
+    PROFILER_PHASE_RIDES,
+    PROFILER_PHASE_PARK,
+    PROFILER_PHASE_RESEARCH,
+    PROFILER_PHASE_RIDE_RATINGS,
+    PROFILER_PHASE_RIDE_MEASUREMENTS,
+    PROFILER_PHASE_NEWS,
+    PROFILER_PHASE_MAP_ANIMATIONS,
+    PROFILER_PHASE_SOUNDS,
+    PROFILER_PHASE_OTHER,
+    PROFILER_PHASE_COUNT
+} PROFILER_PHASE;
+
+typedef struct profiler_phase_summary
+{
+    uint64 calls;       // Times the phase has run since the profiler was last reset
+    double total_ms;    // Time spent in the phase since the profiler was last reset
+    double average_ms;  // Average time per tick over the history
+    double max_ms;      // Longest tick over the history
+} profiler_phase_summary;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    bool profiler_is_enabled();
+    void profiler_set_enabled(bool enabled);
+    void profiler_reset();
+
+    void profiler_tick_begin();
+    void profiler_phase_end(PROFILER_PHASE phase);
+    void profiler_tick_end();
+
+    const utf8 * profiler_get_phase_name(PROFILER_PHASE phase);
+    uint64 profiler_get_tick_count();
+    void profiler_get_phase_summary(PROFILER_PHASE phase, profiler_phase_summary * summary);
+
+    bool profiler_write(const utf8 * path);
+    void profiler_set_output_path(const utf8 * path);
+    void profiler_write_output();
+#ifdef __cplusplus
+}
+#endif
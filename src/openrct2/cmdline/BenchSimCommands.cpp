@@ -0,0 +1,128 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include "../config/Config.h"
+#include "../Context.h"
+#include "../core/Console.hpp"
+#include "../OpenRCT2.h"
+#include "../Profiler.h"
+#include "CommandLine.hpp"
+
+#include "../game.h"
+#include "../intro.h"
+#include "../scenario/scenario.h"
+#include "../world/sprite.h"
+
+using namespace OpenRCT2;
+
+static exitcode_t HandleBenchSim(CommandLineArgEnumerator *argEnumerator);
+
+const CommandLineCommand CommandLine::BenchSimCommands[]
+{
+    // Main commands
+    DefineCommand("", "<file> [ticks]", nullptr, HandleBenchSim),
+    CommandTableEnd
+};
+
+static void PrintPhaseBreakdown(double totalMs)
+{
+    Console::WriteLine("%-20s %10s %10s %12s %7s", "phase", "avg ms", "max ms", "total ms", "share");
+    for (sint32 i = 0; i < PROFILER_PHASE_COUNT; i++)
+    {
+        profiler_phase_summary summary;
+        profiler_get_phase_summary((PROFILER_PHASE)i, &summary);
+        double share = totalMs > 0 ? (summary.total_ms * 100) / totalMs : 0;
+        Console::WriteLine("%-20s %10.3f %10.3f %12.1f %6.1f%%",
+                           profiler_get_phase_name((PROFILER_PHASE)i),
+                           summary.average_ms, summary.max_ms, summary.total_ms, share);
+    }
+}
+
+static exitcode_t HandleBenchSim(CommandLineArgEnumerator *argEnumerator)
+{
+    const char * * argv = (const char * *)argEnumerator->GetArguments() + argEnumerator->GetIndex();
+    sint32 argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    if (argc != 1 && argc != 2)
+    {
+        Console::Error::WriteLine("Usage: openrct2 benchsim <file> [<ticks>]");
+        return EXITCODE_FAIL;
+    }
+
+    const char * inputPath = argv[0];
+    sint32 numTicks = 1000;
+    if (argc == 2)
+    {
+        char * end;
+        errno = 0;
+        long parsedTicks = strtol(argv[1], &end, 10);
+        if (end == argv[1] || *end != '\0' || errno == ERANGE || parsedTicks <= 0 || parsedTicks > INT32_MAX)
+        {
+            Console::Error::WriteLine("Invalid number of ticks: %s", argv[1]);
+            Console::Error::WriteLine("Usage: openrct2 benchsim <file> [<ticks>]");
+            return EXITCODE_FAIL;
+        }
+        numTicks = (sint32)parsedTicks;
+    }
+
+    exitcode_t result = EXITCODE_FAIL;
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+    auto context = CreateContext();
+    if (context->Initialise() && context->LoadParkFromFile(inputPath))
+    {
+        gIntroState = INTRO_STATE_NONE;
+        gScreenFlags = SCREEN_FLAGS_PLAYING;
+
+        // Autosaves are due after wall clock time, so would make runs differ in what they measure
+        sint32 autosaveFrequency = gConfigGeneral.autosave_frequency;
+        gConfigGeneral.autosave_frequency = AUTOSAVE_NEVER;
+
+        bool profilerWasEnabled = profiler_is_enabled();
+        profiler_reset();
+        profiler_set_enabled(true);
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        for (sint32 i = 0; i < numTicks; i++)
+        {
+            game_logic_update();
+        }
+        auto endTime = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double, std::milli> duration = endTime - startTime;
+
+        profiler_set_enabled(profilerWasEnabled);
+        gConfigGeneral.autosave_frequency = autosaveFrequency;
+
+        double ticksPerSecond = duration.count() > 0 ? (numTicks * 1000.0) / duration.count() : 0;
+        Console::WriteLine("Simulated %d ticks of %s in %.2f seconds (%.1f ticks/second).",
+                           numTicks, inputPath, duration.count() / 1000, ticksPerSecond);
+        PrintPhaseBreakdown(duration.count());
+
+        // The resulting game state only depends on the park and tick count, so can be compared between runs
+        const char * checksum = sprite_checksum();
+        Console::WriteLine("Random state: %08X %08X", gScenarioSrand0, gScenarioSrand1);
+        if (checksum != nullptr)
+        {
+            Console::WriteLine("Sprite checksum: %s", checksum);
+        }
+        result = EXITCODE_OK;
+    }
+    delete context;
+    return result;
+}
@@ -31,6 +31,7 @@
 #include "../object/ObjectRepository.h"
 #include "../OpenRCT2.h"
 #include "../PlatformEnvironment.h"
+#include "../Profiler.h"
 #include "../Version.h"
 #include "CommandLine.hpp"
 
@@ -61,6 +62,7 @@ static utf8 * _password        = nullptr;
 static utf8 * _userDataPath    = nullptr;
 static utf8 * _openrctDataPath = nullptr;
 static utf8 * _rct2DataPath    = nullptr;
+static utf8 * _profilePath     = nullptr;
 static bool   _silentBreakpad  = false;
 
 static const CommandLineOptionDefinition StandardOptions[]
@@ -80,6 +82,7 @@ static const CommandLineOptionDefinition StandardOptions[]
     { CMDLINE_TYPE_STRING,  &_userDataPath,    NAC, "user-data-path",    "path to the user data directory (containing config.ini)"    },
     { CMDLINE_TYPE_STRING,  &_openrctDataPath, NAC, "openrct-data-path", "path to the OpenRCT2 data directory (containing languages)" },
     { CMDLINE_TYPE_STRING,  &_rct2DataPath,    NAC, "rct2-data-path",    "path to the RollerCoaster Tycoon 2 data directory (containing data/g1.dat)" },
+    { CMDLINE_TYPE_STRING,  &_profilePath,     NAC, "profile",           "time each game update phase and write the results to a .csv or .json file on exit" },
 #ifdef USE_BREAKPAD
     { CMDLINE_TYPE_SWITCH,  &_silentBreakpad,  NAC, "silent-breakpad",   "make breakpad crash reporting silent"                       },
 #endif // USE_BREAKPAD
@@ -139,6 +142,7 @@ const CommandLineCommand CommandLine::RootCommands[]
     DefineSubCommand("screenshot", CommandLine::ScreenshotCommands),
     DefineSubCommand("sprite",     CommandLine::SpriteCommands    ),
     DefineSubCommand("benchgfx",   CommandLine::BenchGfxCommands  ),
+    DefineSubCommand("benchsim",   CommandLine::BenchSimCommands  ),
 
     CommandTableEnd
 };
@@ -217,6 +221,12 @@ exitcode_t CommandLine::HandleCommandDefault()
         Memory::Free(_password);
     }
 
+    if (_profilePath != nullptr)
+    {
+        profiler_set_output_path(_profilePath);
+        Memory::Free(_profilePath);
+    }
+
     return result;
 }
 
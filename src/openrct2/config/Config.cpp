@@ -187,6 +187,7 @@ namespace Config
             model->scale_quality = reader->GetSint32("scale_quality", 1);
             model->use_nn_at_integer_scales = reader->GetBoolean("use_nn_at_integer_scales", true);
             model->show_fps = reader->GetBoolean("show_fps", false);
+            model->multithreading = reader->GetBoolean("multithreading", false);
             model->trap_cursor = reader->GetBoolean("trap_cursor", false);
             model->auto_open_shops = reader->GetBoolean("auto_open_shops", false);
             model->scenario_select_mode = reader->GetSint32("scenario_select_mode", SCENARIO_SELECT_MODE_ORIGIN);
@@ -257,6 +258,7 @@ namespace Config
         writer->WriteSint32("scale_quality", model->scale_quality);
         writer->WriteBoolean("use_nn_at_integer_scales", model->use_nn_at_integer_scales);
         writer->WriteBoolean("show_fps", model->show_fps);
+        writer->WriteBoolean("multithreading", model->multithreading);
         writer->WriteBoolean("trap_cursor", model->trap_cursor);
         writer->WriteBoolean("auto_open_shops", model->auto_open_shops);
         writer->WriteSint32("scenario_select_mode", model->scenario_select_mode);
@@ -38,6 +38,7 @@ typedef struct GeneralConfiguration
     bool        uncap_fps;
     bool        show_fps;
     bool        minimize_fullscreen_focus_loss;
+    bool        multithreading;
 
     // Map rendering
     bool        landscape_smoothing;
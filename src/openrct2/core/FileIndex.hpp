@@ -17,13 +17,18 @@
 #pragma once
 
 #include <chrono>
+#include <memory>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 #include "../common.h"
+#include "Console.hpp"
 #include "File.h"
 #include "FileScanner.h"
 #include "FileStream.hpp"
+#include "JobPool.hpp"
+#include "MemoryStream.h"
 #include "Path.hpp"
 
 template<typename TItem>
@@ -38,18 +43,42 @@ private:
         uint32 PathChecksum = 0;
     };
 
+    struct ScannedFile
+    {
+        std::string Path;
+        uint64      Size = 0;
+        uint64      LastModified = 0;
+    };
+
     struct ScanResult
     {
         DirectoryStats const Stats;
-        std::vector<std::string> const Files;
+        std::vector<ScannedFile> const Files;
 
-        ScanResult(DirectoryStats stats, std::vector<std::string> files)
+        ScanResult(DirectoryStats stats, std::vector<ScannedFile> files)
             : Stats(stats),
               Files(files)
         {
         }
     };
 
+    /**
+     * A file in the index file, with where its serialised item is in the index file so that only the items of
+     * unchanged files need to be deserialised.
+     */
+    struct IndexEntry
+    {
+        ScannedFile File;
+        uint64      ItemPosition = 0;
+    };
+
+    struct IndexFile
+    {
+        bool                            UpToDate = false;
+        std::unique_ptr<MemoryStream>   Stream;
+        std::vector<IndexEntry>         Entries;
+    };
+
     struct FileIndexHeader
     {
         uint32          HeaderSize = sizeof(FileIndexHeader);
@@ -62,7 +91,7 @@ private:
     };
 
     // Index file format version which when incremented forces a rebuild
-    static constexpr uint8 FILE_INDEX_VERSION = 4;
+    static constexpr uint8 FILE_INDEX_VERSION = 5;
 
     std::string const _name;
     uint32 const _magicNumber;
@@ -103,21 +132,27 @@ public:
     /**
      * Queries and directories and loads the index header. If the index is up to date,
      * the items are loaded from the index and returned, otherwise the index is rebuilt.
+     * Files that have the same size and modification time as when the index was written
+     * keep their item from the index, only new and changed files are loaded again.
      */
     std::vector<TItem> LoadOrBuild() const
     {
         std::vector<TItem> items;
         auto scanResult = Scan();
-        auto readIndexResult = ReadIndexFile(scanResult.Stats);
-        if (std::get<0>(readIndexResult))
+        auto indexFile = ReadIndexFile(scanResult.Stats);
+        if (indexFile.UpToDate)
         {
             // Index was loaded
-            items = std::get<1>(readIndexResult);
+            for (const auto &entry : indexFile.Entries)
+            {
+                indexFile.Stream->SetPosition(entry.ItemPosition);
+                items.push_back(Deserialise(indexFile.Stream.get()));
+            }
         }
         else
         {
-            // Index was not loaded
-            items = Build(scanResult);
+            // Index was not loaded or is out of date
+            items = Build(scanResult, indexFile);
         }
         return items;
     }
@@ -125,7 +160,7 @@ public:
     std::vector<TItem> Rebuild() const
     {
         auto scanResult = Scan();
-        auto items = Build(scanResult);
+        auto items = Build(scanResult, IndexFile());
         return items;
     }
 
@@ -150,7 +185,7 @@ private:
     ScanResult Scan() const
     {
         DirectoryStats stats;
-        std::vector<std::string> files;
+        std::vector<ScannedFile> files;
         for (const auto directory : SearchPaths)
         {
             log_verbose("FileIndex:Scanning for %s in '%s'", _pattern.c_str(), directory.c_str());
@@ -162,7 +197,11 @@ private:
                 auto fileInfo = scanner->GetFileInfo();
                 auto path = std::string(scanner->GetPath());
 
-                files.push_back(path);
+                ScannedFile file;
+                file.Path = path;
+                file.Size = fileInfo->Size;
+                file.LastModified = fileInfo->LastModified;
+                files.push_back(file);
 
                 stats.TotalFiles++;
                 stats.TotalFileSize += fileInfo->Size;
@@ -177,23 +216,65 @@ private:
         return ScanResult(stats, files);
     }
 
-    std::vector<TItem> Build(const ScanResult &scanResult) const
+    std::vector<TItem> Build(const ScanResult &scanResult, const IndexFile &indexFile) const
     {
-        std::vector<TItem> items;
-        Console::WriteLine("Building %s (%zu items)", _name.c_str(), scanResult.Files.size());
-
         auto startTime = std::chrono::high_resolution_clock::now();
-        for (auto filePath : scanResult.Files)
+
+        // Reuse the items of the files that have not changed since the index was written
+        std::unordered_map<std::string, const IndexEntry *> indexEntries;
+        for (const auto &entry : indexFile.Entries)
         {
-            log_verbose("FileIndex:Indexing '%s'", filePath.c_str());
-            auto item = Create(filePath);
-            if (std::get<0>(item))
+            indexEntries[entry.File.Path] = &entry;
+        }
+
+        size_t numFiles = scanResult.Files.size();
+        std::vector<std::tuple<bool, TItem>> results(numFiles);
+        std::vector<size_t> changedFiles;
+        for (size_t i = 0; i < numFiles; i++)
+        {
+            const auto &file = scanResult.Files[i];
+            auto it = indexEntries.find(file.Path);
+            if (it != indexEntries.end() &&
+                it->second->File.Size == file.Size &&
+                it->second->File.LastModified == file.LastModified)
             {
-                items.push_back(std::get<1>(item));
+                indexFile.Stream->SetPosition(it->second->ItemPosition);
+                results[i] = std::make_tuple(true, Deserialise(indexFile.Stream.get()));
+            }
+            else
+            {
+                changedFiles.push_back(i);
             }
         }
+        Console::WriteLine("Building %s (%zu items, %zu new or changed)", _name.c_str(), numFiles, changedFiles.size());
 
-        WriteIndexFile(scanResult.Stats, items);
+        // Load the new and changed files on all cores, each job only writes its own result
+        {
+            JobPool jobPool;
+            for (size_t i : changedFiles)
+            {
+                jobPool.AddTask([this, &scanResult, &results, i]() -> void
+                {
+                    const auto &filePath = scanResult.Files[i].Path;
+                    log_verbose("FileIndex:Indexing '%s'", filePath.c_str());
+                    results[i] = Create(filePath);
+                });
+            }
+            jobPool.Join();
+        }
+
+        std::vector<TItem> items;
+        std::vector<ScannedFile> indexedFiles;
+        for (size_t i = 0; i < numFiles; i++)
+        {
+            if (std::get<0>(results[i]))
+            {
+                items.push_back(std::get<1>(results[i]));
+                indexedFiles.push_back(scanResult.Files[i]);
+            }
+        }
+
+        WriteIndexFile(scanResult.Stats, indexedFiles, items);
 
         auto endTime = std::chrono::high_resolution_clock::now();
         auto duration = (std::chrono::duration<float>)(endTime - startTime);
@@ -201,36 +282,59 @@ private:
         return items;
     }
 
-    std::tuple<bool, std::vector<TItem>> ReadIndexFile(const DirectoryStats &stats) const
+    /**
+     * Reads the list of files in the index file. The whole file is read into memory in one go
+     * and the items are left serialised until they are needed.
+     */
+    IndexFile ReadIndexFile(const DirectoryStats &stats) const
     {
-        bool loadedItems = false;
-        std::vector<TItem> items;
+        IndexFile indexFile;
         try
         {
             log_verbose("FileIndex:Loading index: '%s'", _indexPath.c_str());
-            auto fs = FileStream(_indexPath, FILE_MODE_OPEN);
+            if (!File::Exists(_indexPath))
+            {
+                return indexFile;
+            }
+
+            size_t length;
+            void * data = File::ReadAllBytes(_indexPath, &length);
+            auto stream = std::unique_ptr<MemoryStream>(
+                new MemoryStream(data, length, MEMORY_ACCESS::READ | MEMORY_ACCESS::OWNER));
 
-            // Read header, check if we need to re-scan
-            auto header = fs.ReadValue<FileIndexHeader>();
+            // Read header, check if the items can be used
+            auto header = stream->ReadValue<FileIndexHeader>();
             if (header.HeaderSize == sizeof(FileIndexHeader) &&
                 header.MagicNumber == _magicNumber &&
                 header.VersionA == FILE_INDEX_VERSION &&
                 header.VersionB == _version &&
-                header.LanguageId == gCurrentLanguage &&
-                header.Stats.TotalFiles == stats.TotalFiles &&
-                header.Stats.TotalFileSize == stats.TotalFileSize &&
-                header.Stats.FileDateModifiedChecksum == stats.FileDateModifiedChecksum &&
-                header.Stats.PathChecksum == stats.PathChecksum)
+                header.LanguageId == gCurrentLanguage)
             {
-                // Directory is the same, just read the saved items
                 for (uint32 i = 0; i < header.NumItems; i++)
                 {
-                    auto item = Deserialise(&fs);
-                    items.push_back(item);
+                    IndexEntry entry;
+                    entry.File.Path = stream->ReadStdString();
+                    entry.File.Size = stream->ReadValue<uint64>();
+                    entry.File.LastModified = stream->ReadValue<uint64>();
+                    uint32 itemLength = stream->ReadValue<uint32>();
+                    entry.ItemPosition = stream->GetPosition();
+                    if (entry.ItemPosition + itemLength > stream->GetLength())
+                    {
+                        throw IOException("Index file is truncated.");
+                    }
+                    stream->SetPosition(entry.ItemPosition + itemLength);
+                    indexFile.Entries.push_back(entry);
                 }
-                loadedItems = true;
+                indexFile.Stream = std::move(stream);
+
+                // If nothing in the directories changed, all items can be used as they are
+                indexFile.UpToDate =
+                    header.Stats.TotalFiles == stats.TotalFiles &&
+                    header.Stats.TotalFileSize == stats.TotalFileSize &&
+                    header.Stats.FileDateModifiedChecksum == stats.FileDateModifiedChecksum &&
+                    header.Stats.PathChecksum == stats.PathChecksum;
             }
-            else
+            if (!indexFile.UpToDate)
             {
                 Console::WriteLine("%s out of date", _name.c_str());
             }
@@ -239,17 +343,18 @@ private:
         {
             Console::Error::WriteLine("Unable to load index: '%s'.", _indexPath.c_str());
             Console::Error::WriteLine("%s", e.what());
+            indexFile = IndexFile();
         }
-        return std::make_tuple(loadedItems, items);
+        return indexFile;
     }
 
-    void WriteIndexFile(const DirectoryStats &stats, const std::vector<TItem> &items) const
+    void WriteIndexFile(const DirectoryStats &stats, const std::vector<ScannedFile> &files, const std::vector<TItem> &items) const
     {
         try
         {
             log_verbose("FileIndex:Writing index: '%s'", _indexPath.c_str());
             auto fs = FileStream(_indexPath, FILE_MODE_WRITE);
-    
+
             // Write header
             FileIndexHeader header;
             header.MagicNumber = _magicNumber;
@@ -259,11 +364,20 @@ private:
             header.Stats = stats;
             header.NumItems = (uint32)items.size();
             fs.WriteValue(header);
-    
-            // Write items
-            for (const auto item : items)
+
+            // Write the files and their items, each item is preceded by its length so it can be skipped
+            auto itemStream = MemoryStream();
+            for (size_t i = 0; i < items.size(); i++)
             {
-                Serialise(&fs, item);
+                itemStream.SetPosition(0);
+                Serialise(&itemStream, items[i]);
+                uint32 itemLength = (uint32)itemStream.GetPosition();
+
+                fs.WriteString(files[i].Path);
+                fs.WriteValue<uint64>(files[i].Size);
+                fs.WriteValue<uint64>(files[i].LastModified);
+                fs.WriteValue<uint32>(itemLength);
+                fs.Write(itemStream.GetData(), itemLength);
             }
         }
         catch (const std::exception &e)
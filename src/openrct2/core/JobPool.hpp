@@ -0,0 +1,131 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../common.h"
+
+/**
+ * A fixed set of worker threads that execute queued tasks. Join blocks the calling
+ * thread until every task added so far has finished.
+ */
+class JobPool final
+{
+private:
+    bool                        _shouldStop = false;
+    size_t                      _processing = 0;
+    std::vector<std::thread>    _threads;
+    std::deque<std::function<void()>> _pending;
+    std::condition_variable     _condPending;
+    std::condition_variable     _condComplete;
+    std::mutex                  _mutex;
+
+    typedef std::unique_lock<std::mutex> unique_lock;
+
+public:
+    explicit JobPool(size_t maxThreads = 0)
+    {
+        size_t numThreads = std::thread::hardware_concurrency();
+        if (numThreads == 0)
+        {
+            numThreads = 1;
+        }
+        if (maxThreads != 0 && numThreads > maxThreads)
+        {
+            numThreads = maxThreads;
+        }
+        for (size_t i = 0; i < numThreads; i++)
+        {
+            _threads.emplace_back(&JobPool::ProcessQueue, this);
+        }
+    }
+
+    ~JobPool()
+    {
+        {
+            unique_lock lock(_mutex);
+            _shouldStop = true;
+            _condPending.notify_all();
+        }
+        for (auto &thread : _threads)
+        {
+            thread.join();
+        }
+    }
+
+    size_t GetThreadCount() const
+    {
+        return _threads.size();
+    }
+
+    void AddTask(std::function<void()> workFn)
+    {
+        unique_lock lock(_mutex);
+        _pending.push_back(std::move(workFn));
+        _condPending.notify_one();
+    }
+
+    void Join()
+    {
+        unique_lock lock(_mutex);
+        _condComplete.wait(lock, [this]() -> bool
+        {
+            return _pending.empty() && _processing == 0;
+        });
+    }
+
+private:
+    void ProcessQueue()
+    {
+        unique_lock lock(_mutex);
+        while (true)
+        {
+            _condPending.wait(lock, [this]() -> bool
+            {
+                return _shouldStop || !_pending.empty();
+            });
+            if (_pending.empty())
+            {
+                // Only reached when stopping
+                break;
+            }
+
+            auto workFn = std::move(_pending.front());
+            _pending.pop_front();
+            _processing++;
+
+            lock.unlock();
+            workFn();
+            lock.lock();
+
+            _processing--;
+            if (_pending.empty() && _processing == 0)
+            {
+                _condComplete.notify_all();
+            }
+        }
+    }
+};
+
+#endif
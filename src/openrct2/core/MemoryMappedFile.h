@@ -0,0 +1,49 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include <string>
+#include "../common.h"
+
+/**
+ * A file mapped read-only into memory. Pages are only read from disk when they are first accessed and the page
+ * cache is shared with any other process that maps the same file.
+ */
+class MemoryMappedFile final
+{
+private:
+    const uint8 *   _data = nullptr;
+    size_t          _length = 0;
+#ifdef _WIN32
+    void *          _fileHandle = nullptr;
+    void *          _mappingHandle = nullptr;
+#endif
+
+public:
+    explicit MemoryMappedFile(const std::string &path);
+    ~MemoryMappedFile();
+
+    MemoryMappedFile(const MemoryMappedFile &) = delete;
+    MemoryMappedFile &operator=(const MemoryMappedFile &) = delete;
+
+    const uint8 * GetData() const { return _data; }
+    size_t GetLength() const { return _length; }
+};
+
+#endif
@@ -17,6 +17,7 @@
 #pragma warning(disable : 4127) // conditional expression is constant
 
 #include "drawing.h"
+#include "SpriteBlit.h"
 
 template<sint32 image_type, sint32 zoom_level>
 static void FASTCALL DrawRLESprite2(const uint8* RESTRICT source_bits_pointer,
@@ -105,8 +106,17 @@ static void FASTCALL DrawRLESprite2(const uint8* RESTRICT source_bits_pointer,
 
             //Finally after all those checks, copy the image onto the drawing surface
             //If the image type is not a basic one we require to mix the pixels
+            if (numPixels <= 0)
+            {
+                continue;
+            }
             if (image_type & IMAGE_TYPE_REMAP)  // palette controlled images
             {
+                if (zoom_level == 0 && !(image_type & IMAGE_TYPE_TRANSPARENT))
+                {
+                    SpriteBlit::CopyRemap(copyDest, copySrc, palette_pointer, numPixels);
+                    continue;
+                }
                 for (int j = 0; j < numPixels; j += zoom_amount, copySrc += zoom_amount, copyDest++)
                 {
                     if (image_type & IMAGE_TYPE_TRANSPARENT)
@@ -122,6 +132,11 @@ static void FASTCALL DrawRLESprite2(const uint8* RESTRICT source_bits_pointer,
             }
             else if (image_type & IMAGE_TYPE_TRANSPARENT)  // single alpha blended color (used for glass)
             {
+                if (zoom_level == 0)
+                {
+                    SpriteBlit::Repalette(copyDest, palette_pointer, numPixels);
+                    continue;
+                }
                 for (int j = 0; j < numPixels; j += zoom_amount, copyDest++)
                 {
                     uint8 pixel = *copyDest;
@@ -134,8 +149,7 @@ static void FASTCALL DrawRLESprite2(const uint8* RESTRICT source_bits_pointer,
                 if (zoom_level == 0)
                 {
                     // Since we're sampling each pixel at this zoom level, just do a straight memcpy
-                    if (numPixels > 0)
-                        memcpy(copyDest, copySrc, numPixels);
+                    memcpy(copyDest, copySrc, numPixels);
                 }
                 else
                 {
@@ -170,6 +184,100 @@ static void FASTCALL DrawRLESprite1(const uint8* source_bits_pointer,
     }
 }
 
+/**
+ * Draws a zoomed out sprite from ZoomedSpriteCache, which only has the columns that DrawRLESprite2 would sample, so it
+ * draws the same pixels. source_x_start must be a multiple of the zoom amount, otherwise other columns are sampled.
+ */
+template<sint32 image_type>
+static void FASTCALL DrawZoomedRLESprite(const uint8* RESTRICT source_bits_pointer,
+                                         uint8* RESTRICT dest_bits_pointer,
+                                         const uint8* RESTRICT palette_pointer,
+                                         const rct_drawpixelinfo *RESTRICT dpi,
+                                         sint32 source_y_start,
+                                         sint32 height,
+                                         sint32 source_x_start,
+                                         sint32 width)
+{
+    sint32 zoom_level = dpi->zoom_level;
+    sint32 zoom_amount = 1 << zoom_level;
+    sint32 line_width = (dpi->width >> zoom_level) + dpi->pitch;
+
+    if (source_y_start < 0)
+    {
+        source_y_start    += zoom_amount;
+        height            -= zoom_amount;
+        dest_bits_pointer += line_width;
+    }
+
+    // The columns of the zoomed out sprite that are drawn
+    sint32 zoomed_x_start = source_x_start >> zoom_level;
+    sint32 zoomed_width = (width + zoom_amount - 1) >> zoom_level;
+
+    for (sint32 i = 0; i < height; i += zoom_amount)
+    {
+        sint32 y = source_y_start + i;
+        const uint8 *lineData = source_bits_pointer + ((uint16*)source_bits_pointer)[y];
+        uint8* loop_dest_pointer = dest_bits_pointer + line_width * (i >> zoom_level);
+
+        uint8 isEndOfLine = 0;
+        while (!isEndOfLine)
+        {
+            const uint8* copySrc = lineData;
+            uint8 dataSize    = *copySrc++;
+            uint8 firstPixelX = *copySrc++;
+
+            isEndOfLine = dataSize & 0x80;
+            dataSize &= 0x7F;
+            lineData = copySrc + dataSize;
+
+            sint32 x_start = firstPixelX - zoomed_x_start;
+            sint32 numPixels = dataSize;
+            if (x_start < 0)
+            {
+                copySrc   -= x_start;
+                numPixels += x_start;
+                x_start = 0;
+            }
+            if (x_start + numPixels > zoomed_width)
+            {
+                numPixels = zoomed_width - x_start;
+            }
+            if (numPixels <= 0)
+            {
+                continue;
+            }
+
+            uint8 *copyDest = loop_dest_pointer + x_start;
+            if (image_type & IMAGE_TYPE_REMAP)
+            {
+                if (image_type & IMAGE_TYPE_TRANSPARENT)
+                {
+                    for (int j = 0; j < numPixels; j++, copySrc++, copyDest++)
+                    {
+                        uint16 color = ((*copySrc << 8) | *copyDest) - 0x100;
+                        *copyDest = palette_pointer[color];
+                    }
+                }
+                else
+                {
+                    SpriteBlit::CopyRemap(copyDest, copySrc, palette_pointer, numPixels);
+                }
+            }
+            else if (image_type & IMAGE_TYPE_TRANSPARENT)
+            {
+                SpriteBlit::Repalette(copyDest, palette_pointer, numPixels);
+            }
+            else
+            {
+                memcpy(copyDest, copySrc, numPixels);
+            }
+        }
+    }
+}
+
+#define DrawZoomedRLESpriteHelper(image_type) \
+    DrawZoomedRLESprite<image_type>(source_bits_pointer, dest_bits_pointer, palette_pointer, dpi, source_y_start, height, source_x_start, width)
+
 #define DrawRLESpriteHelper1(image_type) \
     DrawRLESprite1<image_type>(source_bits_pointer, dest_bits_pointer, palette_pointer, dpi, source_y_start, height, source_x_start, width)
 
@@ -210,4 +318,39 @@ extern "C"
             DrawRLESpriteHelper1(IMAGE_TYPE_DEFAULT);
         }
     }
+
+    /**
+     * Transfers zoomed out images from ZoomedSpriteCache onto buffers, taking the same arguments as
+     * gfx_rle_sprite_to_buffer does for the full size image.
+     */
+    void FASTCALL gfx_zoomed_rle_sprite_to_buffer(const uint8* RESTRICT source_bits_pointer,
+                                                    uint8* RESTRICT dest_bits_pointer,
+                                                    const uint8* RESTRICT palette_pointer,
+                                                    const rct_drawpixelinfo * RESTRICT dpi,
+                                                    sint32 image_type,
+                                                    sint32 source_y_start,
+                                                    sint32 height,
+                                                    sint32 source_x_start,
+                                                    sint32 width)
+    {
+        if (image_type & IMAGE_TYPE_REMAP)
+        {
+            if (image_type & IMAGE_TYPE_TRANSPARENT)
+            {
+                DrawZoomedRLESpriteHelper(IMAGE_TYPE_REMAP | IMAGE_TYPE_TRANSPARENT);
+            }
+            else
+            {
+                DrawZoomedRLESpriteHelper(IMAGE_TYPE_REMAP);
+            }
+        }
+        else if (image_type & IMAGE_TYPE_TRANSPARENT)
+        {
+            DrawZoomedRLESpriteHelper(IMAGE_TYPE_TRANSPARENT);
+        }
+        else
+        {
+            DrawZoomedRLESpriteHelper(IMAGE_TYPE_DEFAULT);
+        }
+    }
 }
@@ -35,6 +35,11 @@ enum DRAWING_ENGINE_FLAGS
      * Whether or not the engine will only draw changed blocks of the screen each frame.
      */
     DEF_DIRTY_OPTIMISATIONS = 1 << 0,
+
+    /**
+     * Whether or not drawing contexts can be used from several threads at once, e.g. to paint viewport columns in parallel.
+     */
+    DEF_PARALLEL_DRAWING = 1 << 1,
 };
 
 #ifdef __cplusplus
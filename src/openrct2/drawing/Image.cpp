@@ -22,6 +22,7 @@
 #include "../OpenRCT2.h"
 
 #include "drawing.h"
+#include "ZoomedSpriteCache.h"
 
 constexpr uint32 BASE_IMAGE_ID = 29294;
 constexpr uint32 MAX_IMAGES = 262144;
@@ -225,6 +226,7 @@ extern "C"
             drawing_engine_invalidate_image(imageId);
             imageId++;
         }
+        ZoomedSpriteCache::Invalidate(baseImageId, count);
 
         return baseImageId;
     }
@@ -241,6 +243,7 @@ extern "C"
                 g1Elements[imageId] = { 0 };
                 drawing_engine_invalidate_image(imageId);
             }
+            ZoomedSpriteCache::Invalidate(baseImageId, count);
 
             FreeImageList(baseImageId, count);
         }
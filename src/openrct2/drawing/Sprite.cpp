@@ -21,6 +21,8 @@
 #include "../core/File.h"
 #include "../core/FileStream.hpp"
 #include "../core/Memory.hpp"
+#include "../core/MemoryMappedFile.h"
+#include "../core/MemoryStream.h"
 #include "../core/Path.hpp"
 #include "../core/Util.hpp"
 #include "../OpenRCT2.h"
@@ -32,8 +34,27 @@
 #include "../rct2/addresses.h"
 #include "../util/util.h"
 #include "drawing.h"
+#include "SpriteBlit.h"
+#include "ZoomedSpriteCache.h"
 
 using namespace OpenRCT2;
+
+/**
+ * The peep and other palettes are partially overwritten for every sprite that is drawn. Viewport columns can
+ * be drawn on several threads at once, so each thread works on its own copy of them.
+ */
+struct RemapPalettes
+{
+    uint8 Peep[256];
+    uint8 Other[256];
+
+    RemapPalettes()
+    {
+        memcpy(Peep, gPeepPalette, sizeof(Peep));
+        memcpy(Other, gOtherPalette, sizeof(Other));
+    }
+};
+static thread_local RemapPalettes _remapPalettes;
 using namespace OpenRCT2::Ui;
 
 constexpr struct
@@ -156,9 +177,50 @@ static void read_and_convert_gxdat(IStream * stream, size_t count, bool is_rctc,
     Memory::Free(g1Elements32);
 }
 
+/**
+ * Maps a g1 style file and reads its element headers, pointing the elements at their data in the mapped file. None of
+ * the sprite data is read from disk until it is drawn. is_rctc is only given for g1.dat, which must have all of the
+ * RCT2 elements and may be the one from RCTC.
+ */
+static MemoryMappedFile * map_gxdat(const std::string &path, rct_g1_header * header, bool * is_rctc, rct_g1_element * * elements, void * * data)
+{
+    auto file = std::unique_ptr<MemoryMappedFile>(new MemoryMappedFile(path));
+    auto stream = MemoryStream(file->GetData(), file->GetLength());
+    *header = stream.ReadValue<rct_g1_header>();
+    if (is_rctc != nullptr)
+    {
+        if (header->num_entries < SPR_G1_END)
+        {
+            throw Exception("Not enough elements in g1.dat");
+        }
+        *is_rctc = header->num_entries == SPR_RCTC_G1_END;
+    }
+
+    // Read element headers
+    if (*elements == nullptr)
+    {
+        *elements = Memory::AllocateArray<rct_g1_element>(header->num_entries);
+    }
+    read_and_convert_gxdat(&stream, header->num_entries, is_rctc != nullptr && *is_rctc, *elements);
+
+    // Fix entry data offsets
+    size_t dataOffset = (size_t)stream.GetPosition();
+    if (header->total_size > file->GetLength() - dataOffset)
+    {
+        throw IOException("Sprite data is truncated");
+    }
+    *data = (void *)(file->GetData() + dataOffset);
+    for (uint32 i = 0; i < header->num_entries; i++)
+    {
+        (*elements)[i].offset += (uintptr_t)*data;
+    }
+    return file.release();
+}
+
 extern "C"
 {
-    static void *   _g1Buffer = nullptr;
+    static MemoryMappedFile *   _g1File = nullptr;
+    static MemoryMappedFile *   _g2File = nullptr;
     static rct_gx   _g2 = { 0 };
     static rct_gx   _csg = { 0 };
     static bool     _csgLoaded = false;
@@ -182,30 +244,15 @@ extern "C"
         try
         {
             auto path = Path::Combine(env->GetDirectoryPath(DIRBASE::RCT2, DIRID::DATA), "g1.dat");
-            auto fs = FileStream(path, FILE_MODE_OPEN);
-            rct_g1_header header = fs.ReadValue<rct_g1_header>();
-
-            if (header.num_entries < SPR_G1_END)
-            {
-                throw Exception("Not enough elements in g1.dat");
-            }
 
-            // Read element headers
 #ifdef NO_RCT2
             g1Elements = Memory::AllocateArray<rct_g1_element>(324206);
 #endif
-            bool is_rctc = header.num_entries == SPR_RCTC_G1_END;
-            read_and_convert_gxdat(&fs, header.num_entries, is_rctc, g1Elements);
+            rct_g1_header header;
+            bool is_rctc;
+            void * data;
+            _g1File = map_gxdat(path, &header, &is_rctc, &g1Elements, &data);
             gTinyFontAntiAliased = is_rctc;
-
-            // Read element data
-            _g1Buffer = fs.ReadArray<uint8>(header.total_size);
-
-            // Fix entry data offsets
-            for (uint32 i = 0; i < header.num_entries; i++)
-            {
-                g1Elements[i].offset += (uintptr_t)_g1Buffer;
-            }
             return true;
         }
         catch (const Exception &)
@@ -222,7 +269,9 @@ extern "C"
 
     void gfx_unload_g1()
     {
-        SafeFree(_g1Buffer);
+        ZoomedSpriteCache::Clear();
+        delete _g1File;
+        _g1File = nullptr;
     #ifdef NO_RCT2
         SafeFree(g1Elements);
     #endif
@@ -230,12 +279,16 @@ extern "C"
 
     void gfx_unload_g2()
     {
+        ZoomedSpriteCache::Clear();
         SafeFree(_g2.elements);
-        SafeFree(_g2.data);
+        _g2.data = nullptr;
+        delete _g2File;
+        _g2File = nullptr;
     }
 
     void gfx_unload_csg()
     {
+        ZoomedSpriteCache::Clear();
         SafeFree(_csg.elements);
         SafeFree(_csg.data);
     }
@@ -250,21 +303,7 @@ extern "C"
         safe_strcat_path(path, "g2.dat", MAX_PATH);
         try
         {
-            auto fs = FileStream(path, FILE_MODE_OPEN);
-            _g2.header = fs.ReadValue<rct_g1_header>();
-
-            // Read element headers
-            _g2.elements = Memory::AllocateArray<rct_g1_element>(_g2.header.num_entries);
-            read_and_convert_gxdat(&fs, _g2.header.num_entries, false, _g2.elements);
-
-            // Read element data
-            _g2.data = fs.ReadArray<uint8>(_g2.header.total_size);
-
-            // Fix entry data offsets
-            for (uint32 i = 0; i < _g2.header.num_entries; i++)
-            {
-                _g2.elements[i].offset += (uintptr_t)_g2.data;
-            }
+            _g2File = map_gxdat(path, &_g2.header, nullptr, &_g2.elements, &_g2.data);
             return true;
         }
         catch (const Exception &)
@@ -375,6 +414,30 @@ extern "C"
         uint32 dest_line_width = (dest_dpi->width / zoom_amount) + dest_dpi->pitch;
         uint32 source_line_width = source_image->width * zoom_amount;
 
+        // At full size each line is contiguous and is drawn by the line kernels
+        if (zoom_level == 0){
+            for (; height > 0; height--, source_pointer += source_line_width, dest_pointer += dest_line_width){
+                if (width <= 0){
+                    continue;
+                }
+                if (image_type & IMAGE_TYPE_REMAP){
+                    assert(palette_pointer != nullptr);
+                    SpriteBlit::CopyRemapMasked(dest_pointer, source_pointer, palette_pointer, width);
+                }
+                else if (image_type & IMAGE_TYPE_TRANSPARENT){
+                    assert(palette_pointer != nullptr);
+                    SpriteBlit::RepaletteMasked(dest_pointer, source_pointer, palette_pointer, width);
+                }
+                else if (!(source_image->flags & G1_FLAG_BMP)){
+                    memcpy(dest_pointer, source_pointer, width);
+                }
+                else{
+                    SpriteBlit::CopyMasked(dest_pointer, source_pointer, width);
+                }
+            }
+            return;
+        }
+
         // Image uses the palette pointer to remap the colours of the image
         if (image_type & IMAGE_TYPE_REMAP){
             assert(palette_pointer != nullptr);
@@ -469,13 +532,13 @@ extern "C"
             return g1Elements[palette_offset].offset;
         }
         else {
-            uint8* palette_pointer = gPeepPalette;
+            uint8* palette_pointer = _remapPalettes.Peep;
 
             uint32 primary_offset = palette_to_g1_offset[(image_id >> 19) & 0x1F];
             uint32 secondary_offset = palette_to_g1_offset[(image_id >> 24) & 0x1F];
 
             if (!(image_type & IMAGE_TYPE_REMAP)) {
-                palette_pointer = gOtherPalette;
+                palette_pointer = _remapPalettes.Other;
     #if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
                 assert(tertiary_colour < PALETTE_TO_G1_OFFSET_COUNT);
     #endif // DEBUG_LEVEL_2
@@ -659,6 +722,15 @@ extern "C"
         dest_pointer += ((dpi->width >> zoom_level) + dpi->pitch) * dest_start_y + dest_start_x;
 
         if (g1_source->flags & G1_FLAG_RLE_COMPRESSION){
+            // Zoomed out, draw the columns that would be sampled from a copy with only those columns
+            if (zoom_level != 0 && (source_start_x & ~zoom_mask) == 0){
+                auto zoomedSprite = ZoomedSpriteCache::Get(image_element, g1_source, zoom_level);
+                if (zoomedSprite != nullptr){
+                    gfx_zoomed_rle_sprite_to_buffer(zoomedSprite->data(), dest_pointer, palette_pointer, dpi, image_type, source_start_y, height, source_start_x, width);
+                    return;
+                }
+            }
+
             // We have to use a different method to move the source pointer for
             // rle encoded sprites so that will be handled within this function
             gfx_rle_sprite_to_buffer(g1_source->offset, dest_pointer, palette_pointer, dpi, image_type, source_start_y, height, source_start_x, width);
@@ -0,0 +1,264 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #include <cpuid.h>
+    #include <emmintrin.h>
+    #define OpenRCT2_SSE2_GNUC
+    #define OpenRCT2_SSE2_TARGET __attribute__((target("sse2")))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #include <emmintrin.h>
+    #define OpenRCT2_SSE2_MSVC
+    #define OpenRCT2_SSE2_TARGET
+#endif
+
+#include "SpriteBlit.h"
+
+namespace SpriteBlit
+{
+    static void CopyMaskedPlain(uint8 * RESTRICT dst, const uint8 * RESTRICT src, size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            uint8 pixel = src[i];
+            if (pixel)
+            {
+                dst[i] = pixel;
+            }
+        }
+    }
+
+    static void CopyRemapMaskedPlain(uint8 * RESTRICT dst, const uint8 * RESTRICT src, const uint8 * RESTRICT palette, size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            uint8 pixel = palette[src[i]];
+            if (pixel)
+            {
+                dst[i] = pixel;
+            }
+        }
+    }
+
+    static void RepaletteMaskedPlain(uint8 * RESTRICT dst, const uint8 * RESTRICT src, const uint8 * RESTRICT palette, size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            if (src[i])
+            {
+                dst[i] = palette[dst[i]];
+            }
+        }
+    }
+
+#if defined(OpenRCT2_SSE2_GNUC) || defined(OpenRCT2_SSE2_MSVC)
+    static bool Sse2Available()
+    {
+        // SSE2 support is declared as the 26th bit of EDX with CPUID(EAX = 1).
+    #if defined(OpenRCT2_SSE2_GNUC)
+        uint32 eax, ebx, ecx, edx = 0; // avoid "maybe uninitialized"
+        __get_cpuid(1, &eax, &ebx, &ecx, &edx);
+        return (edx & (1 << 26)) != 0;
+    #else
+        sint32 regs[4];
+        __cpuid(regs, 1);
+        return (regs[3] & (1 << 26)) != 0;
+    #endif
+    }
+
+    /**
+     * Picks src where it is not 0 and dst where it is, 16 pixels at a time.
+     */
+    OpenRCT2_SSE2_TARGET
+    static void CopyMaskedSse2(uint8 * RESTRICT dst, const uint8 * RESTRICT src, size_t count)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            __m128i source = _mm_loadu_si128((const __m128i *)(src + i));
+            __m128i transparent = _mm_cmpeq_epi8(source, zero);
+            sint32 transparentMask = _mm_movemask_epi8(transparent);
+            if (transparentMask == 0xFFFF)
+            {
+                continue;
+            }
+            if (transparentMask == 0)
+            {
+                _mm_storeu_si128((__m128i *)(dst + i), source);
+                continue;
+            }
+            __m128i dest = _mm_loadu_si128((const __m128i *)(dst + i));
+            __m128i result = _mm_or_si128(_mm_and_si128(transparent, dest), _mm_andnot_si128(transparent, source));
+            _mm_storeu_si128((__m128i *)(dst + i), result);
+        }
+        CopyMaskedPlain(dst + i, src + i, count - i);
+    }
+
+    /**
+     * The palette lookups stay one pixel at a time, SSE2 has no byte gather, but the remapped pixels are written out
+     * 16 at a time and runs of 16 transparent pixels are skipped without a lookup.
+     */
+    OpenRCT2_SSE2_TARGET
+    static void CopyRemapMaskedSse2(uint8 * RESTRICT dst, const uint8 * RESTRICT src, const uint8 * RESTRICT palette, size_t count)
+    {
+        // Palettes used for remapping always map 0 to 0, but that is only an optimisation here
+        bool zeroIsTransparent = palette[0] == 0;
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            __m128i source = _mm_loadu_si128((const __m128i *)(src + i));
+            if (zeroIsTransparent && _mm_movemask_epi8(_mm_cmpeq_epi8(source, _mm_setzero_si128())) == 0xFFFF)
+            {
+                continue;
+            }
+
+            alignas(16) uint8 remapped[16];
+            for (sint32 j = 0; j < 16; j++)
+            {
+                remapped[j] = palette[src[i + j]];
+            }
+            CopyMaskedSse2(dst + i, remapped, 16);
+        }
+        CopyRemapMaskedPlain(dst + i, src + i, palette, count - i);
+    }
+
+    OpenRCT2_SSE2_TARGET
+    static void RepaletteMaskedSse2(uint8 * RESTRICT dst, const uint8 * RESTRICT src, const uint8 * RESTRICT palette, size_t count)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            __m128i source = _mm_loadu_si128((const __m128i *)(src + i));
+            sint32 transparentMask = _mm_movemask_epi8(_mm_cmpeq_epi8(source, zero));
+            if (transparentMask == 0xFFFF)
+            {
+                continue;
+            }
+            for (sint32 j = 0; j < 16; j++)
+            {
+                if (!(transparentMask & (1 << j)))
+                {
+                    dst[i + j] = palette[dst[i + j]];
+                }
+            }
+        }
+        RepaletteMaskedPlain(dst + i, src + i, palette, count - i);
+    }
+
+    static bool _useSse2 = Sse2Available();
+
+    bool IsSse2Available()
+    {
+        return Sse2Available();
+    }
+
+    void UseSse2(bool enabled)
+    {
+        _useSse2 = enabled && Sse2Available();
+    }
+#else
+    static constexpr bool _useSse2 = false;
+
+    bool IsSse2Available()
+    {
+        return false;
+    }
+
+    void UseSse2(bool enabled)
+    {
+    }
+#endif
+
+    void CopyMasked(uint8 * RESTRICT dst, const uint8 * RESTRICT src, size_t count)
+    {
+#if defined(OpenRCT2_SSE2_GNUC) || defined(OpenRCT2_SSE2_MSVC)
+        if (_useSse2)
+        {
+            CopyMaskedSse2(dst, src, count);
+            return;
+        }
+#endif
+        CopyMaskedPlain(dst, src, count);
+    }
+
+    void CopyRemapMasked(uint8 * RESTRICT dst, const uint8 * RESTRICT src, const uint8 * RESTRICT palette, size_t count)
+    {
+#if defined(OpenRCT2_SSE2_GNUC) || defined(OpenRCT2_SSE2_MSVC)
+        if (_useSse2)
+        {
+            CopyRemapMaskedSse2(dst, src, palette, count);
+            return;
+        }
+#endif
+        CopyRemapMaskedPlain(dst, src, palette, count);
+    }
+
+    void RepaletteMasked(uint8 * RESTRICT dst, const uint8 * RESTRICT src, const uint8 * RESTRICT palette, size_t count)
+    {
+#if defined(OpenRCT2_SSE2_GNUC) || defined(OpenRCT2_SSE2_MSVC)
+        if (_useSse2)
+        {
+            RepaletteMaskedSse2(dst, src, palette, count);
+            return;
+        }
+#endif
+        RepaletteMaskedPlain(dst, src, palette, count);
+    }
+
+    void CopyRemap(uint8 * RESTRICT dst, const uint8 * RESTRICT src, const uint8 * RESTRICT palette, size_t count)
+    {
+        // Unrolled so the lookups of neighbouring pixels do not wait on each other
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            uint8 a = palette[src[i + 0]];
+            uint8 b = palette[src[i + 1]];
+            uint8 c = palette[src[i + 2]];
+            uint8 d = palette[src[i + 3]];
+            dst[i + 0] = a;
+            dst[i + 1] = b;
+            dst[i + 2] = c;
+            dst[i + 3] = d;
+        }
+        for (; i < count; i++)
+        {
+            dst[i] = palette[src[i]];
+        }
+    }
+
+    void Repalette(uint8 * RESTRICT dst, const uint8 * RESTRICT palette, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            uint8 a = palette[dst[i + 0]];
+            uint8 b = palette[dst[i + 1]];
+            uint8 c = palette[dst[i + 2]];
+            uint8 d = palette[dst[i + 3]];
+            dst[i + 0] = a;
+            dst[i + 1] = b;
+            dst[i + 2] = c;
+            dst[i + 3] = d;
+        }
+        for (; i < count; i++)
+        {
+            dst[i] = palette[dst[i]];
+        }
+    }
+}
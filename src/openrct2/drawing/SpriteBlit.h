@@ -0,0 +1,47 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include "../common.h"
+
+/**
+ * Kernels for drawing a line of sprite pixels at full size. They are written for SSE2 where it helps, with plain
+ * versions for other CPUs, and both produce exactly the same pixels as drawing the pixels one at a time.
+ */
+namespace SpriteBlit
+{
+    // dst = src, skipping pixels where src is 0
+    void CopyMasked(uint8 * RESTRICT dst, const uint8 * RESTRICT src, size_t count);
+    // dst = palette[src], skipping pixels where palette[src] is 0
+    void CopyRemapMasked(uint8 * RESTRICT dst, const uint8 * RESTRICT src, const uint8 * RESTRICT palette, size_t count);
+    // dst = palette[src]
+    void CopyRemap(uint8 * RESTRICT dst, const uint8 * RESTRICT src, const uint8 * RESTRICT palette, size_t count);
+    // dst = palette[dst], skipping pixels where src is 0
+    void RepaletteMasked(uint8 * RESTRICT dst, const uint8 * RESTRICT src, const uint8 * RESTRICT palette, size_t count);
+    // dst = palette[dst]
+    void Repalette(uint8 * RESTRICT dst, const uint8 * RESTRICT palette, size_t count);
+
+    bool IsSse2Available();
+    /**
+     * Chooses whether the SSE2 kernels are used, they are by default when the CPU supports them.
+     */
+    void UseSse2(bool enabled);
+}
+
+#endif
@@ -90,7 +90,6 @@ namespace OpenRCT2
     #endif
 
             X8RainDrawer        _rainDrawer;
-            X8DrawingContext *  _drawingContext;
 
         public:
             explicit X8DrawingEngine(Ui::IUiContext * uiContext);
@@ -149,6 +148,7 @@ namespace OpenRCT2
             void DrawSpriteSolid(uint32 image, sint32 x, sint32 y, uint8 colour) override;
             void DrawGlyph(uint32 image, sint32 x, sint32 y, uint8 * palette) override;
 
+            void SetEngine(X8DrawingEngine * engine);
             void SetDPI(rct_drawpixelinfo * dpi);
         };
     }
@@ -0,0 +1,219 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include "ZoomedSpriteCache.h"
+
+namespace ZoomedSpriteCache
+{
+    // Amount of memory the zoomed out sprites may take up
+    constexpr size_t MAX_CACHE_SIZE = 32 * 1024 * 1024;
+    constexpr sint32 MAX_ZOOM_LEVEL = 3;
+
+    struct CacheEntry
+    {
+        uint64              Key;
+        const uint8 *       Source;
+        Sprite              Data;
+        // Set when drawn, so the entry is passed over once when making room
+        std::atomic<bool>   Referenced;
+
+        CacheEntry(uint64 key, const uint8 * source, Sprite data)
+            : Key(key),
+              Source(source),
+              Data(data),
+              Referenced(false)
+        {
+        }
+    };
+
+    // Drawing threads only look up sprites, which they do under a shared lock. Entries are dropped in clock order
+    // rather than strictly least recently drawn first, so a lookup does not have to move its entry.
+    static std::shared_timed_mutex _mutex;
+    static std::list<CacheEntry> _entries;
+    static std::list<CacheEntry>::iterator _clockHand = _entries.end();
+    static std::unordered_map<uint64, std::list<CacheEntry>::iterator> _entryMap;
+    static size_t _cacheSize = 0;
+
+    static uint64 GetKey(uint32 image, sint32 zoomLevel)
+    {
+        return ((uint64)image << 2) | (uint64)zoomLevel;
+    }
+
+    static void RemoveEntry(std::list<CacheEntry>::iterator it)
+    {
+        if (it == _clockHand)
+        {
+            _clockHand++;
+        }
+        _cacheSize -= it->Data->size();
+        _entryMap.erase(it->Key);
+        _entries.erase(it);
+    }
+
+    /**
+     * Makes the zoomed out sprite. Runs keep the zoomed out columns of their pixels, those that have no pixel in a
+     * zoomed out column are dropped and a line without any is left with a single empty run.
+     */
+    static Sprite CreateSprite(const rct_g1_element * g1, sint32 zoomLevel)
+    {
+        const uint8 * source = g1->offset;
+        sint32 zoomAmount = 1 << zoomLevel;
+        sint32 height = g1->height;
+
+        auto data = std::make_shared<std::vector<uint8>>();
+        data->resize(height * sizeof(uint16));
+        for (sint32 y = 0; y < height; y++)
+        {
+            // Lines can not get longer, so the offsets fit if those of the sprite did
+            size_t lineOffset = data->size();
+            if (lineOffset > UINT16_MAX)
+            {
+                return nullptr;
+            }
+            (*data)[y * 2 + 0] = (uint8)(lineOffset & 0xFF);
+            (*data)[y * 2 + 1] = (uint8)(lineOffset >> 8);
+
+            const uint8 * lineData = source + ((const uint16 *)source)[y];
+            size_t lastRun = SIZE_MAX;
+            uint8 isEndOfLine = 0;
+            while (!isEndOfLine)
+            {
+                uint8 dataSize = *lineData++;
+                uint8 firstPixelX = *lineData++;
+                isEndOfLine = dataSize & 0x80;
+                dataSize &= 0x7F;
+
+                sint32 zoomedStart = (firstPixelX + zoomAmount - 1) >> zoomLevel;
+                sint32 zoomedEnd = (firstPixelX + dataSize + zoomAmount - 1) >> zoomLevel;
+                if (zoomedEnd > zoomedStart)
+                {
+                    lastRun = data->size();
+                    data->push_back((uint8)(zoomedEnd - zoomedStart));
+                    data->push_back((uint8)zoomedStart);
+                    for (sint32 x = zoomedStart; x < zoomedEnd; x++)
+                    {
+                        data->push_back(lineData[(x << zoomLevel) - firstPixelX]);
+                    }
+                }
+                lineData += dataSize;
+            }
+
+            if (lastRun == SIZE_MAX)
+            {
+                data->push_back(0x80);
+                data->push_back(0);
+            }
+            else
+            {
+                (*data)[lastRun] |= 0x80;
+            }
+        }
+        data->shrink_to_fit();
+        return data;
+    }
+
+    Sprite Get(uint32 image, const rct_g1_element * g1, sint32 zoomLevel)
+    {
+        if (zoomLevel <= 0 || zoomLevel > MAX_ZOOM_LEVEL || !(g1->flags & G1_FLAG_RLE_COMPRESSION) || g1->offset == nullptr)
+        {
+            return nullptr;
+        }
+
+        uint64 key = GetKey(image, zoomLevel);
+        {
+            std::shared_lock<std::shared_timed_mutex> lock(_mutex);
+            auto kvp = _entryMap.find(key);
+            if (kvp != _entryMap.end() && kvp->second->Source == g1->offset)
+            {
+                auto it = kvp->second;
+                if (!it->Referenced.load(std::memory_order_relaxed))
+                {
+                    it->Referenced.store(true, std::memory_order_relaxed);
+                }
+                return it->Data;
+            }
+        }
+
+        // Made outside of the lock so other threads can carry on drawing, if two threads make the same sprite the
+        // second one replaces the first. An entry for image data that has since been replaced is replaced as well.
+        Sprite sprite = CreateSprite(g1, zoomLevel);
+        if (sprite == nullptr || sprite->size() > MAX_CACHE_SIZE / 4)
+        {
+            return sprite;
+        }
+
+        std::lock_guard<std::shared_timed_mutex> lock(_mutex);
+        auto kvp = _entryMap.find(key);
+        if (kvp != _entryMap.end())
+        {
+            RemoveEntry(kvp->second);
+        }
+        while (_cacheSize + sprite->size() > MAX_CACHE_SIZE && !_entries.empty())
+        {
+            if (_clockHand == _entries.end())
+            {
+                _clockHand = _entries.begin();
+            }
+            if (_clockHand->Referenced.exchange(false, std::memory_order_relaxed))
+            {
+                _clockHand++;
+            }
+            else
+            {
+                RemoveEntry(_clockHand);
+            }
+        }
+        // Added right behind the hand, so it is the last entry the hand comes across
+        auto it = _entries.emplace(_clockHand, key, g1->offset, sprite);
+        _entryMap[key] = it;
+        _cacheSize += sprite->size();
+        return sprite;
+    }
+
+    void Invalidate(uint32 baseImageId, uint32 count)
+    {
+        std::lock_guard<std::shared_timed_mutex> lock(_mutex);
+        if (_entryMap.empty())
+        {
+            return;
+        }
+        for (uint32 image = baseImageId; image < baseImageId + count; image++)
+        {
+            for (sint32 zoomLevel = 1; zoomLevel <= MAX_ZOOM_LEVEL; zoomLevel++)
+            {
+                auto kvp = _entryMap.find(GetKey(image, zoomLevel));
+                if (kvp != _entryMap.end())
+                {
+                    RemoveEntry(kvp->second);
+                }
+            }
+        }
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::shared_timed_mutex> lock(_mutex);
+        _entries.clear();
+        _entryMap.clear();
+        _clockHand = _entries.end();
+        _cacheSize = 0;
+    }
+}
@@ -0,0 +1,47 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include <memory>
+#include <vector>
+#include "../common.h"
+#include "drawing.h"
+
+/**
+ * RLE sprites with only every 2nd, 4th or 8th column of each line, as drawn when zoomed out. The lines are still in
+ * the RLE format, in zoomed out columns, so the zoomed out pixels of a run are next to each other and are drawn like
+ * a sprite at full size. All rows are kept as the rows that are drawn depend on where the sprite is drawn.
+ *
+ * The sprites are made when first drawn and those not drawn for a while are dropped once the cache is full. The images
+ * of objects have to be invalidated when they are freed or replaced, which gfx_object_free_images and
+ * gfx_object_allocate_images do.
+ */
+namespace ZoomedSpriteCache
+{
+    using Sprite = std::shared_ptr<const std::vector<uint8>>;
+
+    /**
+     * Gets the given RLE sprite with only every (1 << zoomLevel)th column, or nullptr if it can not be zoomed out.
+     */
+    Sprite Get(uint32 image, const rct_g1_element * g1, sint32 zoomLevel);
+    void Invalidate(uint32 baseImageId, uint32 count);
+    void Clear();
+}
+
+#endif
@@ -17,6 +17,7 @@
 #include "../common.h"
 #include "../Context.h"
 #include "../core/Guard.hpp"
+#include "../interface/viewport.h"
 #include "../interface/window.h"
 #include "../localisation/localisation.h"
 #include "../object.h"
@@ -550,6 +551,7 @@ void load_palette()
  */
 void gfx_invalidate_screen()
 {
+    viewport_pick_cache_invalidate();
     gfx_set_dirty_blocks(0, 0, context_get_width(), context_get_height());
 }
 
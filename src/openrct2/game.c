@@ -35,6 +35,7 @@
 #include "object.h"
 #include "OpenRCT2.h"
 #include "ParkImporter.h"
+#include "Profiler.h"
 #include "peep/peep.h"
 #include "peep/staff.h"
 #include "platform/platform.h"
@@ -285,6 +286,9 @@ void game_update()
 {
     gInUpdateCode = true;
 
+    // Nothing holds on to map elements between frames, so the element store can be grown here
+    map_element_reserve_margin();
+
     sint32 numUpdates;
 
     // 0x006E3AEC // screen_game_process_mouse_input();
@@ -383,6 +387,8 @@ void game_update()
 
 void game_logic_update()
 {
+    map_element_reserve_margin();
+
     network_update();
 
     if (network_get_mode() == NETWORK_MODE_CLIENT && network_get_status() == NETWORK_STATUS_CONNECTED && network_get_authstatus() == NETWORK_AUTH_OK) {
@@ -393,36 +399,54 @@ void game_logic_update()
         }
     }
 
+    // Only ticks that are run are profiled, receiving from the network is left out as it happens either way
+    profiler_tick_begin();
+
     // Separated out processing commands in network_update which could call scenario_rand where gInUpdateCode is false.
     // All commands that are received are first queued and then executed where gInUpdateCode is set to true.
     network_process_game_commands();
+    profiler_phase_end(PROFILER_PHASE_NETWORK);
 
     gScreenAge++;
     if (gScreenAge == 0)
         gScreenAge--;
 
-    sub_68B089();
     scenario_update();
+    profiler_phase_end(PROFILER_PHASE_SCENARIO);
     climate_update();
+    profiler_phase_end(PROFILER_PHASE_CLIMATE);
     map_update_tiles();
+    profiler_phase_end(PROFILER_PHASE_MAP_TILES);
     // Temporarily remove provisional paths to prevent peep from interacting with them
     map_remove_provisional_elements();
     map_update_path_wide_flags();
+    profiler_phase_end(PROFILER_PHASE_PATH_WIDE_FLAGS);
     peep_update_all();
     map_restore_provisional_elements();
+    profiler_phase_end(PROFILER_PHASE_PEEPS);
     vehicle_update_all();
+    profiler_phase_end(PROFILER_PHASE_VEHICLES);
     sprite_misc_update_all();
+    profiler_phase_end(PROFILER_PHASE_MISC_SPRITES);
     ride_update_all();
+    profiler_phase_end(PROFILER_PHASE_RIDES);
     park_update();
+    profiler_phase_end(PROFILER_PHASE_PARK);
     research_update();
+    profiler_phase_end(PROFILER_PHASE_RESEARCH);
     ride_ratings_update_all();
+    profiler_phase_end(PROFILER_PHASE_RIDE_RATINGS);
     ride_measurements_update();
+    profiler_phase_end(PROFILER_PHASE_RIDE_MEASUREMENTS);
     news_item_update_current();
+    profiler_phase_end(PROFILER_PHASE_NEWS);
 
     map_animation_invalidate_all();
+    profiler_phase_end(PROFILER_PHASE_MAP_ANIMATIONS);
     vehicle_sounds_update();
     peep_update_crowd_noise();
     climate_update_sound();
+    profiler_phase_end(PROFILER_PHASE_SOUNDS);
     editor_open_windows_for_current_step();
 
     // Update windows
@@ -445,6 +469,8 @@ void game_logic_update()
         gLastAutoSaveUpdate = platform_get_ticks();
     }
 
+    profiler_tick_end();
+
     gCurrentTicks++;
     gScenarioTicks++;
     gSavedAge++;
@@ -574,6 +600,9 @@ sint32 game_do_command_p(sint32 command, sint32 *eax, sint32 *ebx, sint32 *ecx,
             // Second call to actually perform the operation
             new_game_command_table[command](eax, ebx, ecx, edx, esi, edi, ebp);
 
+            // Most commands edit the map in place, e.g. footpath edges, without inserting or removing elements
+            peep_pathfind_cache_invalidate();
+
             // Do the callback (required for multiplayer to work correctly), but only for top level commands
             if (gGameCommandNestLevel == 1) {
                 if (game_command_callback && !(flags & GAME_COMMAND_FLAG_GHOST))
@@ -1240,87 +1269,6 @@ void save_game_as()
     intent_release(intent);
 }
 
-static sint32 compare_autosave_file_paths (const void * a, const void * b ) {
-    return strcmp(*(char **)a, *(char **)b);
-}
-
-static void limit_autosave_count(const size_t numberOfFilesToKeep, bool processLandscapeFolder)
-{
-    sint32 fileEnumHandle = 0;
-
-    size_t autosavesCount = 0;
-    size_t numAutosavesToDelete = 0;
-
-    file_info fileInfo;
-
-    utf8 filter[MAX_PATH];
-
-    utf8 **autosaveFiles = NULL;
-
-    size_t i=0;
-
-    if (processLandscapeFolder) {
-        platform_get_user_directory(filter, "landscape", sizeof(filter));
-        safe_strcat_path(filter, "autosave", sizeof(filter));
-        safe_strcat_path(filter, "autosave_*.sc6", sizeof(filter));
-    } else {
-        platform_get_user_directory(filter, "save", sizeof(filter));
-        safe_strcat_path(filter, "autosave", sizeof(filter));
-        safe_strcat_path(filter, "autosave_*.sv6", sizeof(filter));
-    }
-
-    // At first, count how many autosaves there are
-    fileEnumHandle = platform_enumerate_files_begin(filter);
-    while (platform_enumerate_files_next(fileEnumHandle, &fileInfo)) {
-        autosavesCount++;
-    }
-    platform_enumerate_files_end(fileEnumHandle);
-
-    // If there are fewer autosaves than the number of files to keep we don't need to delete anything
-    if(autosavesCount <= numberOfFilesToKeep) {
-        return;
-    }
-
-    autosaveFiles = (utf8**) malloc(sizeof(utf8*) * autosavesCount);
-
-    fileEnumHandle = platform_enumerate_files_begin(filter);
-    for(i = 0; i < autosavesCount; i++) {
-        autosaveFiles[i] = (utf8*)malloc(sizeof(utf8) * MAX_PATH);
-        memset(autosaveFiles[i], 0, sizeof(utf8) * MAX_PATH);
-
-        if(platform_enumerate_files_next(fileEnumHandle, &fileInfo)) {
-            if (processLandscapeFolder) {
-                platform_get_user_directory(autosaveFiles[i], "landscape", sizeof(utf8) * MAX_PATH);
-            } else {
-                platform_get_user_directory(autosaveFiles[i], "save", sizeof(utf8) * MAX_PATH);
-            }
-            safe_strcat_path(autosaveFiles[i], "autosave", sizeof(utf8) * MAX_PATH);
-            safe_strcat_path(autosaveFiles[i], fileInfo.path, sizeof(utf8) * MAX_PATH);
-        }
-    }
-    platform_enumerate_files_end(fileEnumHandle);
-
-    qsort (autosaveFiles, autosavesCount, sizeof (char*), compare_autosave_file_paths);
-
-    // Calculate how many saves we need to delete.
-    numAutosavesToDelete = autosavesCount - numberOfFilesToKeep;
-
-    i=0;
-    while (numAutosavesToDelete > 0) {
-        platform_file_delete(autosaveFiles[i]);
-
-        i++;
-        numAutosavesToDelete--;
-    }
-
-
-    for(i = 0; i < autosavesCount; i++) {
-        free(autosaveFiles[i]);
-    }
-
-    free(autosaveFiles);
-}
-
 void game_autosave()
 {
     const char * subDirectory = "save";
@@ -1343,24 +1291,23 @@ void game_autosave()
         currentDate.year, currentDate.month, currentDate.day, currentTime.hour,
         currentTime.minute, currentTime.second, fileExtension);
 
-    limit_autosave_count(NUMBER_OF_AUTOSAVES_TO_KEEP, (gScreenFlags & SCREEN_FLAGS_EDITOR));
-
     utf8 path[MAX_PATH];
     utf8 backupPath[MAX_PATH];
+    utf8 pattern[MAX_PATH];
     platform_get_user_directory(path, subDirectory, sizeof(path));
     safe_strcat_path(path, "autosave", sizeof(path));
     platform_ensure_directory_exists(path);
     safe_strcpy(backupPath, path, sizeof(backupPath));
+    safe_strcpy(pattern, path, sizeof(pattern));
     safe_strcat_path(path, timeName, sizeof(path));
     safe_strcat_path(backupPath, "autosave", sizeof(backupPath));
     safe_strcat(backupPath, fileExtension, sizeof(backupPath));
     safe_strcat(backupPath, ".bak", sizeof(backupPath));
+    safe_strcat_path(pattern, "autosave_*", sizeof(pattern));
+    safe_strcat(pattern, fileExtension, sizeof(pattern));
 
-    if (platform_file_exists(path)) {
-        platform_file_copy(path, backupPath, true);
-    }
-
-    scenario_save(path, saveFlags);
+    // Only the export happens here, the autosave is written and old ones are removed in the background
+    scenario_autosave(path, backupPath, pattern, NUMBER_OF_AUTOSAVES_TO_KEEP, saveFlags);
 }
 
 /**
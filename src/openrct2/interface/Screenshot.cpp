@@ -15,10 +15,15 @@
 #pragma endregion
 
 #include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include "../audio/audio.h"
 #include "../config/Config.h"
 #include "../Context.h"
 #include "../core/Console.hpp"
+#include "../core/Math.hpp"
 #include "../Imaging.h"
 #include "../OpenRCT2.h"
 #include "Screenshot.h"
@@ -33,6 +38,94 @@
 
 using namespace OpenRCT2;
 
+// Height in pixels of each band a large viewport is rendered in, and how many bands may be held in memory at once
+constexpr sint32 SCREENSHOT_BAND_HEIGHT = 256;
+constexpr sint32 SCREENSHOT_BAND_COUNT = 3;
+
+/**
+ * Renders the whole viewport to a PNG without allocating a bitmap for all of it. The viewport is painted in
+ * horizontal bands on the calling thread (which spreads each band's columns over the paint job threads when
+ * enabled) while the bands already painted are compressed and written out on a separate thread.
+ */
+static bool screenshot_render_viewport_png(rct_viewport * viewport, const rct_palette * palette, const utf8 * path)
+{
+    sint32 width = viewport->width;
+    sint32 height = viewport->height;
+    sint32 numBands = (height + SCREENSHOT_BAND_HEIGHT - 1) / SCREENSHOT_BAND_HEIGHT;
+
+    std::vector<uint8> bands[SCREENSHOT_BAND_COUNT];
+    for (auto &band : bands)
+    {
+        band.resize((size_t)width * SCREENSHOT_BAND_HEIGHT);
+    }
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    sint32 numBandsPainted = 0;
+    sint32 numBandsWritten = 0;
+    bool writerFinished = false;
+    bool result = false;
+
+    std::thread writer([&]() -> void
+    {
+        bool written = Imaging::PngWriteRows(width, height, palette, path, [&](sint32 y) -> const uint8 *
+        {
+            sint32 bandIndex = y / SCREENSHOT_BAND_HEIGHT;
+            std::unique_lock<std::mutex> lock(mutex);
+            if (bandIndex > numBandsWritten)
+            {
+                // libpng has copied every row of the previous band, so its buffer can be painted over
+                numBandsWritten = bandIndex;
+                cond.notify_all();
+            }
+            cond.wait(lock, [&]() -> bool { return numBandsPainted > bandIndex; });
+            return bands[bandIndex % SCREENSHOT_BAND_COUNT].data() + ((y % SCREENSHOT_BAND_HEIGHT) * width);
+        });
+
+        std::unique_lock<std::mutex> lock(mutex);
+        result = written;
+        writerFinished = true;
+        cond.notify_all();
+    });
+
+    for (sint32 bandIndex = 0; bandIndex < numBands; bandIndex++)
+    {
+        {
+            // Wait for a free buffer, or stop painting if the writer has given up
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [&]() -> bool
+            {
+                return writerFinished || bandIndex - numBandsWritten < SCREENSHOT_BAND_COUNT;
+            });
+            if (writerFinished)
+            {
+                break;
+            }
+        }
+
+        std::vector<uint8> &band = bands[bandIndex % SCREENSHOT_BAND_COUNT];
+        std::fill(band.begin(), band.end(), 0);
+
+        sint32 top = bandIndex * SCREENSHOT_BAND_HEIGHT;
+        rct_drawpixelinfo dpi;
+        dpi.x = 0;
+        dpi.y = top;
+        dpi.width = width;
+        dpi.height = Math::Min(SCREENSHOT_BAND_HEIGHT, height - top);
+        dpi.pitch = 0;
+        dpi.zoom_level = 0;
+        dpi.bits = band.data();
+        viewport_render(&dpi, viewport, 0, top, width, top + dpi.height);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        numBandsPainted = bandIndex + 1;
+        cond.notify_all();
+    }
+
+    writer.join();
+    return result;
+}
+
 extern "C"
 {
 uint8 gScreenshotCountdown = 0;
@@ -209,17 +302,6 @@ void screenshot_giant()
     // Ensure sprites appear regardless of rotation
     reset_all_sprite_quadrant_placements();
 
-    rct_drawpixelinfo dpi;
-    dpi.x = 0;
-    dpi.y = 0;
-    dpi.width = resolutionWidth;
-    dpi.height = resolutionHeight;
-    dpi.pitch = 0;
-    dpi.zoom_level = 0;
-    dpi.bits = (uint8 *)malloc(dpi.width * dpi.height);
-
-    viewport_render(&dpi, &viewport, 0, 0, viewport.width, viewport.height);
-
     // Get a free screenshot path
     char path[MAX_PATH];
     sint32 index;
@@ -232,9 +314,11 @@ void screenshot_giant()
     rct_palette renderedPalette;
     screenshot_get_rendered_palette(&renderedPalette);
 
-    image_io_png_write(&dpi, &renderedPalette, path);
-
-    free(dpi.bits);
+    if (!screenshot_render_viewport_png(&viewport, &renderedPalette, path)) {
+        log_error("Giant screenshot failed, unable to write %s.", path);
+        context_show_error(STR_SCREENSHOT_FAILED, STR_NONE);
+        return;
+    }
 
     // Show user that screenshot saved successfully
     set_format_arg(0, rct_string_id, STR_STRING);
@@ -448,23 +532,13 @@ sint32 cmdline_for_screenshot(const char **argv, sint32 argc)
         // Ensure sprites appear regardless of rotation
         reset_all_sprite_quadrant_placements();
 
-        rct_drawpixelinfo dpi;
-        dpi.x = 0;
-        dpi.y = 0;
-        dpi.width = resolutionWidth;
-        dpi.height = resolutionHeight;
-        dpi.pitch = 0;
-        dpi.zoom_level = 0;
-        dpi.bits = (uint8 *)malloc(dpi.width * dpi.height);
-
-        viewport_render(&dpi, &viewport, 0, 0, viewport.width, viewport.height);
-
         rct_palette renderedPalette;
         screenshot_get_rendered_palette(&renderedPalette);
 
-        image_io_png_write(&dpi, &renderedPalette, outputPath);
+        if (!screenshot_render_viewport_png(&viewport, &renderedPalette, outputPath)) {
+            Console::Error::WriteLine("Unable to write screenshot to '%s'.", outputPath);
+        }
 
-        free(dpi.bits);
         drawing_engine_dispose();
     }
     delete context;
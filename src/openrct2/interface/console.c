@@ -34,6 +34,7 @@
 #include "../OpenRCT2.h"
 #include "../peep/staff.h"
 #include "../platform/platform.h"
+#include "../Profiler.h"
 #include "../ride/ride.h"
 #include "../ride/ride_data.h"
 #include "../util/sawyercoding.h"
@@ -1207,6 +1208,42 @@ static sint32 cc_open(const utf8 **argv, sint32 argc) {
     return 0;
 }
 
+static sint32 cc_profiler(const utf8 **argv, sint32 argc)
+{
+    if (argc > 0) {
+        if (strcmp(argv[0], "start") == 0) {
+            profiler_set_enabled(true);
+            console_writeline("Profiler started.");
+            return 0;
+        } else if (strcmp(argv[0], "stop") == 0) {
+            profiler_set_enabled(false);
+            console_writeline("Profiler stopped.");
+            return 0;
+        } else if (strcmp(argv[0], "reset") == 0) {
+            profiler_reset();
+            return 0;
+        } else if (strcmp(argv[0], "show") == 0) {
+            console_printf("%u ticks recorded, averages over the last %d ticks", (uint32)profiler_get_tick_count(), PROFILER_HISTORY_SIZE);
+            console_printf("%-20s %10s %10s %10s %12s", "phase", "calls", "avg ms", "max ms", "total ms");
+            for (sint32 i = 0; i < PROFILER_PHASE_COUNT; i++) {
+                profiler_phase_summary summary;
+                profiler_get_phase_summary(i, &summary);
+                console_printf("%-20s %10u %10.3f %10.3f %12.1f", profiler_get_phase_name(i), (uint32)summary.calls, summary.average_ms, summary.max_ms, summary.total_ms);
+            }
+            return 0;
+        } else if (strcmp(argv[0], "dump") == 0 && argc > 1) {
+            if (profiler_write(argv[1])) {
+                console_printf("Profile written to %s", argv[1]);
+                return 0;
+            }
+            console_writeline_error("Unable to write profile.");
+            return 1;
+        }
+    }
+    console_printf("subcommands: start, stop, reset, show, dump <file.csv|file.json>");
+    return 0;
+}
+
 static sint32 cc_remove_unused_objects(const utf8 **argv, sint32 argc) 
 {
     sint32 result = editor_remove_unused_objects();
@@ -1289,6 +1326,7 @@ console_command console_command_table[] = {
     { "rides", cc_rides, "Ride management.", "rides <subcommand>" },
     { "staff", cc_staff, "Staff management.", "staff <subcommand>"},
     { "remove_unused_objects", cc_remove_unused_objects, "Removes all the unused objects from the object selection.", "remove_unused_objects" },
+    { "profiler", cc_profiler, "Times each phase of the game update.", "profiler <subcommand>" },
 };
 
 static sint32 cc_windows(const utf8 **argv, sint32 argc) {
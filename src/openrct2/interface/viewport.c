@@ -66,7 +66,54 @@ static sint16 _interactionMapX;
 static sint16 _interactionMapY;
 static uint16 _unk9AC154;
 
+/**
+ * Hit-testing a pixel paints the part of the map under it and tests the sprites of every paint struct against it. The
+ * paint structs hit at a pixel are kept in draw order for a few pixels, so hit-testing such a pixel again, with any
+ * interaction mask, only looks up the last hit that is not masked. A kept pixel is dropped whenever the area it is in
+ * is invalidated for drawing, or the map elements are moved or replaced.
+ */
+
+// Number of pixels whose hits are kept
+#define VIEWPORT_PICK_CACHE_SIZE 8
+// Pixels with more hits than this are not kept
+#define VIEWPORT_PICK_MAX_HITS 64
+
+typedef struct viewport_pick_hit {
+    uint8 sprite_type;
+    sint16 map_x;
+    sint16 map_y;
+    rct_map_element * map_element;
+} viewport_pick_hit;
+
+typedef struct viewport_pick_entry {
+    bool valid;
+    sint32 x;
+    sint32 y;
+    uint8 zoom;
+    uint8 rotation;
+    uint8 clip_height;
+    uint32 view_flags;
+    uint32 last_used;
+    uint32 num_hits;
+    viewport_pick_hit hits[VIEWPORT_PICK_MAX_HITS];
+} viewport_pick_entry;
+
+static viewport_pick_entry _viewportPickCache[VIEWPORT_PICK_CACHE_SIZE];
+static uint32 _viewportPickCacheTime;
+
+// Hits of the pixel being hit-tested
+static viewport_pick_hit * _viewportPickHits;
+static uint32 _viewportPickHitCount;
+static uint32 _viewportPickHitCapacity;
+
+typedef struct viewport_paint_column_jobs {
+    rct_drawpixelinfo * columns;
+    sint32 count;
+    uint32 view_flags;
+} viewport_paint_column_jobs;
+
 static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32 viewFlags);
+static void viewport_paint_column_job(sint32 index, void * arg);
 static void viewport_paint_weather_gloom(rct_drawpixelinfo * dpi);
 
 /**
@@ -708,6 +755,16 @@ void viewport_paint(rct_viewport* viewport, rct_drawpixelinfo* dpi, sint16 left,
     // this as well as the [x += 32] in the loop causes signed integer overflow -> undefined behaviour.
     sint16 rightBorder = dpi1.x + dpi1.width;
 
+    gCurrentViewportFlags = viewFlags;
+
+    // Columns do not overlap and each gets its own paint session, so they can be painted on the job threads
+    viewport_paint_column_jobs jobs = { 0 };
+    if (paint_jobs_enabled()) {
+        sint32 maxColumns = ((rightBorder - floor2(dpi1.x, 32)) / 32) + 1;
+        jobs.columns = malloc(maxColumns * sizeof(rct_drawpixelinfo));
+        jobs.view_flags = viewFlags;
+    }
+
     // Splits the area into 32 pixel columns and renders them
     for (x = floor2(dpi1.x, 32); x < rightBorder; x += 32) {
         rct_drawpixelinfo dpi2 = dpi1;
@@ -727,14 +784,27 @@ void viewport_paint(rct_viewport* viewport, rct_drawpixelinfo* dpi, sint16 left,
         }
         dpi2.width = paintRight - dpi2.x;
 
-        viewport_paint_column(&dpi2, viewFlags);
+        if (jobs.columns != NULL) {
+            jobs.columns[jobs.count++] = dpi2;
+        } else {
+            viewport_paint_column(&dpi2, viewFlags);
+        }
+    }
+
+    if (jobs.columns != NULL) {
+        paint_jobs_run(viewport_paint_column_job, jobs.count, &jobs);
+        free(jobs.columns);
     }
 }
 
-static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32 viewFlags)
+static void viewport_paint_column_job(sint32 index, void * arg)
 {
-    gCurrentViewportFlags = viewFlags;
+    viewport_paint_column_jobs * jobs = (viewport_paint_column_jobs *)arg;
+    viewport_paint_column(&jobs->columns[index], jobs->view_flags);
+}
 
+static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32 viewFlags)
+{
     if (viewFlags & (VIEWPORT_FLAG_HIDE_VERTICAL | VIEWPORT_FLAG_HIDE_BASE | VIEWPORT_FLAG_UNDERGROUND_INSIDE | VIEWPORT_FLAG_PAINT_CLIP_TO_HEIGHT)) {
         uint8 colour = 10;
         if (viewFlags & VIEWPORT_FLAG_INVISIBLE_SPRITES) {
@@ -747,7 +817,6 @@ static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32 viewFlags)
     paint_session_generate(session);
     paint_struct ps = paint_session_arrange(session);
     paint_draw_structs(dpi, &ps, viewFlags);
-    paint_session_free(session);
 
     if (gConfigGeneral.render_weather_gloom &&
         !gTrackDesignSaveMode &&
@@ -757,8 +826,12 @@ static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32 viewFlags)
     }
 
     if (session->PSStringHead != NULL) {
+        // String formatting and fonts are shared with other paint threads
+        paint_shared_state_lock();
         paint_draw_money_structs(dpi, session->PSStringHead);
+        paint_shared_state_unlock();
     }
+    paint_session_free(session);
 }
 
 static void viewport_paint_weather_gloom(rct_drawpixelinfo * dpi)
@@ -1002,29 +1075,124 @@ void viewport_set_visibility(uint8 mode)
     }
 }
 
+static uint16 viewport_pick_hit_get_mask(const viewport_pick_hit *hit)
+{
+    if (hit->sprite_type == VIEWPORT_INTERACTION_ITEM_BANNER)
+        // I think CS made a typo here. Let's replicate the original behaviour.
+        return 1 << (hit->sprite_type - 3);
+    else
+        return 1 << (hit->sprite_type - 1);
+}
+
 /**
- * Stores some info about the element pointed at, if requested for this particular type through the interaction mask.
+ * Keeps a paint struct hit at the pixel being hit-tested, if it is something that can be interacted with.
  * Originally checked 0x0141F569 at start
  *  rct2: 0x00688697
  */
-static void store_interaction_info(paint_struct *ps)
+static void viewport_pick_add_hit(paint_struct *ps)
 {
     if (ps->sprite_type == VIEWPORT_INTERACTION_ITEM_NONE
         || ps->sprite_type == 11 // 11 as a type seems to not exist, maybe part of the typo mentioned later on.
         || ps->sprite_type > VIEWPORT_INTERACTION_ITEM_BANNER) return;
 
-    uint16 mask;
-    if (ps->sprite_type == VIEWPORT_INTERACTION_ITEM_BANNER)
-        // I think CS made a typo here. Let's replicate the original behaviour.
-        mask = 1 << (ps->sprite_type - 3);
-    else
-        mask = 1 << (ps->sprite_type - 1);
+    if (_viewportPickHitCount == _viewportPickHitCapacity) {
+        uint32 capacity = max(VIEWPORT_PICK_MAX_HITS, _viewportPickHitCapacity * 2);
+        viewport_pick_hit * hits = realloc(_viewportPickHits, capacity * sizeof(viewport_pick_hit));
+        if (hits == NULL) {
+            log_error("Unable to allocate memory for viewport hits.");
+            return;
+        }
+        _viewportPickHits = hits;
+        _viewportPickHitCapacity = capacity;
+    }
+
+    viewport_pick_hit * hit = &_viewportPickHits[_viewportPickHitCount++];
+    hit->sprite_type = ps->sprite_type;
+    hit->map_x = ps->map_x;
+    hit->map_y = ps->map_y;
+    hit->map_element = ps->mapElement;
+}
 
-    if (!(_unk9AC154 & mask)) {
-        _interactionSpriteType = ps->sprite_type;
-        _interactionMapX = ps->map_x;
-        _interactionMapY = ps->map_y;
-        _interaction_element = ps->mapElement;
+/**
+ * Stores some info about the element pointed at, if requested for this particular type through the interaction mask.
+ * The last hit in draw order that is not masked is the one on top.
+ */
+static void store_interaction_info(const viewport_pick_hit *hits, uint32 count)
+{
+    for (uint32 i = count; i > 0; i--) {
+        const viewport_pick_hit * hit = &hits[i - 1];
+        if (!(_unk9AC154 & viewport_pick_hit_get_mask(hit))) {
+            _interactionSpriteType = hit->sprite_type;
+            _interactionMapX = hit->map_x;
+            _interactionMapY = hit->map_y;
+            _interaction_element = hit->map_element;
+            return;
+        }
+    }
+}
+
+static viewport_pick_entry * viewport_pick_cache_find(sint32 x, sint32 y, uint8 zoom)
+{
+    uint8 rotation = get_current_rotation();
+    for (sint32 i = 0; i < VIEWPORT_PICK_CACHE_SIZE; i++) {
+        viewport_pick_entry * entry = &_viewportPickCache[i];
+        if (entry->valid && entry->x == x && entry->y == y && entry->zoom == zoom && entry->rotation == rotation &&
+            entry->clip_height == gClipHeight && entry->view_flags == gCurrentViewportFlags
+        ) {
+            entry->last_used = ++_viewportPickCacheTime;
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void viewport_pick_cache_add(sint32 x, sint32 y, uint8 zoom, const viewport_pick_hit *hits, uint32 count)
+{
+    if (count > VIEWPORT_PICK_MAX_HITS) {
+        return;
+    }
+
+    viewport_pick_entry * entry = &_viewportPickCache[0];
+    for (sint32 i = 1; i < VIEWPORT_PICK_CACHE_SIZE && entry->valid; i++) {
+        viewport_pick_entry * other = &_viewportPickCache[i];
+        if (!other->valid || other->last_used < entry->last_used) {
+            entry = other;
+        }
+    }
+
+    entry->valid = true;
+    entry->x = x;
+    entry->y = y;
+    entry->zoom = zoom;
+    entry->rotation = get_current_rotation();
+    entry->clip_height = gClipHeight;
+    entry->view_flags = gCurrentViewportFlags;
+    entry->last_used = ++_viewportPickCacheTime;
+    entry->num_hits = count;
+    memcpy(entry->hits, hits, count * sizeof(viewport_pick_hit));
+}
+
+/**
+ * Drops the kept hits of all pixels, must be called whenever the map elements have been moved or replaced.
+ */
+void viewport_pick_cache_invalidate()
+{
+    for (sint32 i = 0; i < VIEWPORT_PICK_CACHE_SIZE; i++) {
+        _viewportPickCache[i].valid = false;
+    }
+}
+
+/**
+ * Drops the kept hits of the pixels in the given area, in view coordinates at zoom 0.
+ */
+static void viewport_pick_cache_invalidate_rect(sint32 left, sint32 top, sint32 right, sint32 bottom)
+{
+    for (sint32 i = 0; i < VIEWPORT_PICK_CACHE_SIZE; i++) {
+        viewport_pick_entry * entry = &_viewportPickCache[i];
+        sint32 size = 1 << entry->zoom;
+        if (entry->valid && entry->x < right && entry->x + size > left && entry->y < bottom && entry->y + size > top) {
+            entry->valid = false;
+        }
     }
 }
 
@@ -1314,7 +1482,7 @@ static void sub_68862C(rct_drawpixelinfo * dpi, paint_struct * ps)
         while (next_ps != NULL) {
             ps = next_ps;
             if (sub_679023(dpi, ps->image_id, ps->x, ps->y))
-                store_interaction_info(ps);
+                viewport_pick_add_hit(ps);
 
             next_ps = ps->var_20;
         }
@@ -1326,7 +1494,7 @@ static void sub_68862C(rct_drawpixelinfo * dpi, paint_struct * ps)
                 (attached_ps->x + ps->x) & 0xFFFF,
                 (attached_ps->y + ps->y) & 0xFFFF
             )) {
-                store_interaction_info(ps);
+                viewport_pick_add_hit(ps);
             }
         }
 
@@ -1362,23 +1530,33 @@ void get_map_coordinates_from_pos(sint32 screenX, sint32 screenY, sint32 flags,
             screenY <<= myviewport->zoom;
             screenX += (sint32)myviewport->view_x;
             screenY += (sint32)myviewport->view_y;
-            _viewportDpi1.zoom_level = myviewport->zoom;
-            screenX &= (0xFFFF << myviewport->zoom) & 0xFFFF;
-            screenY &= (0xFFFF << myviewport->zoom) & 0xFFFF;
-            _viewportDpi1.x = screenX;
-            _viewportDpi1.y = screenY;
-            rct_drawpixelinfo* dpi = &_viewportDpi2;
-            dpi->y = _viewportDpi1.y;
-            dpi->height = 1;
-            dpi->zoom_level = _viewportDpi1.zoom_level;
-            dpi->x = _viewportDpi1.x;
-            dpi->width = 1;
-
-            paint_session * session = paint_session_alloc(dpi);
-            paint_session_generate(session);
-            paint_struct ps = paint_session_arrange(session);
-            sub_68862C(dpi, &ps);
-            paint_session_free(session);
+            screenX &= ~((1 << myviewport->zoom) - 1);
+            screenY &= ~((1 << myviewport->zoom) - 1);
+
+            viewport_pick_entry * entry = viewport_pick_cache_find(screenX, screenY, myviewport->zoom);
+            if (entry != NULL) {
+                store_interaction_info(entry->hits, entry->num_hits);
+            } else {
+                _viewportDpi1.zoom_level = myviewport->zoom;
+                _viewportDpi1.x = screenX & 0xFFFF;
+                _viewportDpi1.y = screenY & 0xFFFF;
+                rct_drawpixelinfo* dpi = &_viewportDpi2;
+                dpi->y = _viewportDpi1.y;
+                dpi->height = 1;
+                dpi->zoom_level = _viewportDpi1.zoom_level;
+                dpi->x = _viewportDpi1.x;
+                dpi->width = 1;
+
+                _viewportPickHitCount = 0;
+                paint_session * session = paint_session_alloc(dpi);
+                paint_session_generate(session);
+                paint_struct ps = paint_session_arrange(session);
+                sub_68862C(dpi, &ps);
+                paint_session_free(session);
+
+                store_interaction_info(_viewportPickHits, _viewportPickHitCount);
+                viewport_pick_cache_add(screenX, screenY, myviewport->zoom, _viewportPickHits, _viewportPickHitCount);
+            }
         }
         if (viewport != NULL) *viewport = myviewport;
     }
@@ -1393,6 +1571,9 @@ void get_map_coordinates_from_pos(sint32 screenX, sint32 screenY, sint32 flags,
  */
 void viewport_invalidate(rct_viewport *viewport, sint32 left, sint32 top, sint32 right, sint32 bottom)
 {
+    // Whatever is drawn differently in this area may be hit differently as well
+    viewport_pick_cache_invalidate_rect(left, top, right, bottom);
+
     // if unknown viewport visibility, use the containing window to discover the status
     if (viewport->visibility == VC_UNKNOWN)
     {
@@ -29,6 +29,9 @@
 #define ACTION_COOLDOWN_TIME_PLACE_SCENERY  20
 #define ACTION_COOLDOWN_TIME_DEMOLISH_RIDE  1000
 
+// Number of maps sent to clients that are kept to send only the changes to clients that reconnect
+#define MAX_MAP_KEYFRAMES 4
+
 rct_peep* _pickup_peep = 0;
 sint32 _pickup_peep_old_x = SPRITE_LOCATION_NULL;
 
@@ -173,6 +176,7 @@ void Network::Close()
         listening_socket = nullptr;
         delete _advertiser;
         _advertiser = nullptr;
+        _mapKeyframes.clear();
     }
 
     CloseChatLog();
@@ -958,6 +962,8 @@ void Network::Client_Send_OBJECTS(const std::vector<std::string> &objects)
         log_verbose("client requests object %s", objects[i].c_str());
         packet->Write((const uint8 *)objects[i].c_str(), 8);
     }
+    // The last map we loaded, the server can send what changed since instead of the whole map
+    packet->WriteString(_mapKeyframeHash.c_str());
     server_connection->QueuePacket(std::move(packet));
 }
 
@@ -1013,72 +1019,62 @@ void Network::Server_Send_MAP(NetworkConnection* connection)
         objects = objManager->GetPackableObjects();
     }
 
-    size_t out_size;
-    uint8 * header = save_for_network(out_size, objects);
-    if (header == nullptr) {
+    std::vector<uint8> data;
+    if (!save_for_network(data, objects)) {
         if (connection) {
             connection->SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
             connection->Socket->Disconnect();
         }
         return;
     }
-    size_t chunksize = 65000;
-    for (size_t i = 0; i < out_size; i += chunksize) {
-        size_t datasize = Math::Min(chunksize, out_size - i);
-        std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
-        *packet << (uint32)NETWORK_COMMAND_MAP << (uint32)out_size << (uint32)i;
-        packet->Write(&header[i], datasize);
-        if (connection) {
-            connection->QueuePacket(std::move(packet));
-        } else {
-            SendPacketToClients(*packet);
+
+    // Keep the last few maps sent, so a client that reconnects only needs to be sent what has changed since. The maps
+    // are hashed by their streams, a map that has not been hashed yet can not be the one the client has.
+    std::shared_ptr<NetworkMapKeyframe> base;
+    if (connection != nullptr && !connection->MapKeyframeHash.empty()) {
+        for (const auto &keyframe : _mapKeyframes) {
+            if (keyframe->Hashed && keyframe->Hash == connection->MapKeyframeHash) {
+                base = keyframe;
+                break;
+            }
+        }
+    }
+    auto keyframe = std::make_shared<NetworkMapKeyframe>();
+    keyframe->Data = std::move(data);
+    _mapKeyframes.push_back(keyframe);
+    while (_mapKeyframes.size() > MAX_MAP_KEYFRAMES) {
+        _mapKeyframes.pop_front();
+    }
+
+    // Compared with the base and compressed on a background thread, the connections send the chunks as they are produced
+    auto mapStream = std::make_shared<NetworkMapStream>(keyframe, base);
+    if (connection) {
+        connection->QueueMap(mapStream);
+    } else {
+        for (auto &clientConnection : client_connection_list) {
+            // Connections that are still joining are sent the map once they have been authenticated
+            if (clientConnection->AuthStatus == NETWORK_AUTH_OK && clientConnection->Player != nullptr) {
+                clientConnection->QueueMap(mapStream);
+            }
         }
     }
-    free(header);
 }
 
-uint8 * Network::save_for_network(size_t &out_size, const std::vector<const ObjectRepositoryItem *> &objects) const
+bool Network::save_for_network(std::vector<uint8> &data, const std::vector<const ObjectRepositoryItem *> &objects) const
 {
-    uint8 * header = nullptr;
-    out_size = 0;
     bool RLEState = gUseRLE;
     gUseRLE = false;
 
     auto ms = MemoryStream();
     if (!SaveMap(&ms, objects)) {
         log_warning("Failed to export map.");
-        return nullptr;
+        return false;
     }
     gUseRLE = RLEState;
 
-    const void * data = ms.GetData();
-    sint32 size = ms.GetLength();
-
-    uint8 *compressed = util_zlib_deflate((const uint8 *)data, size, &out_size);
-    if (compressed != nullptr)
-    {
-        header = (uint8 *)_strdup("open2_sv6_zlib");
-        size_t header_len = strlen((char *)header) + 1; // account for null terminator
-        header = (uint8 *)realloc(header, header_len + out_size);
-        if (header == nullptr) {
-            log_error("Failed to allocate %u bytes.", header_len + out_size);
-        } else {
-            memcpy(&header[header_len], compressed, out_size);
-            out_size += header_len;
-            log_verbose("Sending map of size %u bytes, compressed to %u bytes", size, out_size);
-        }
-        free(compressed);
-    } else {
-        log_warning("Failed to compress the data, falling back to non-compressed sv6.");
-        header = (uint8 *)malloc(size);
-        if (header == nullptr) {
-            log_error("Failed to allocate %u bytes.", size);
-        } else {
-            out_size = size;
-            memcpy(header, data, size);
-        }
-    }
-    return header;
+    const uint8 * msData = (const uint8 *)ms.GetData();
+    data.assign(msData, msData + ms.GetLength());
+    return true;
 }
 
 void Network::Client_Send_CHAT(const char* text)
@@ -1717,6 +1713,10 @@ void Network::Server_Handle_OBJECTS(NetworkConnection& connection, NetworkPacket
             connection.RequestedObjects.push_back(item);
         }
     }
+    const char * keyframeHash = packet.ReadString();
+    if (keyframeHash != nullptr) {
+        connection.MapKeyframeHash = keyframeHash;
+    }
 
     const char * player_name = (const char *) connection.Player->Name.c_str();
     Server_Send_MAP(&connection);
@@ -1816,45 +1816,53 @@ void Network::Server_Handle_AUTH(NetworkConnection& connection, NetworkPacket& p
 
 void Network::Client_Handle_MAP(NetworkConnection& connection, NetworkPacket& packet)
 {
+    // The total size is 0 until the server has finished compressing the map
     uint32 size, offset;
     packet >> size >> offset;
     sint32 chunksize = (sint32)(packet.Size - packet.BytesRead);
     if (chunksize <= 0) {
         return;
     }
-    if (size > chunk_buffer.size()) {
-        chunk_buffer.resize(size);
+    if (offset == 0) {
+        _mapReader = std::unique_ptr<NetworkMapReader>(new NetworkMapReader());
+    }
+    if (_mapReader == nullptr || offset != _mapReader->GetReceivedSize()) {
+        log_warning("Received map chunk at unexpected offset %u", offset);
+        return;
     }
     char str_downloading_map[256];
-    uint32 downloading_map_args[2] = {(offset + chunksize) / 1024, size / 1024};
+    uint32 downloading_map_args[2] = {(offset + chunksize) / 1024, (size != 0 ? size : offset + chunksize) / 1024};
     format_string(str_downloading_map, 256, STR_MULTIPLAYER_DOWNLOADING_MAP, downloading_map_args);
     window_network_status_open(str_downloading_map, []() -> void {
         gNetwork.Close();
     });
-    memcpy(&chunk_buffer[offset], (void*)packet.Read(chunksize), chunksize);
+    if (!_mapReader->Append(packet.Read(chunksize), chunksize)) {
+        log_warning("Failed to decompress data sent from server.");
+        _mapReader = nullptr;
+        Close();
+        return;
+    }
     if (offset + chunksize == size) {
         window_network_status_close();
-        bool has_to_free = false;
-        uint8 *data = &chunk_buffer[0];
-        size_t data_size = size;
-        // zlib-compressed
-        if (strcmp("open2_sv6_zlib", (char *)&chunk_buffer[0]) == 0)
-        {
-            log_verbose("Received zlib-compressed sv6 map");
-            has_to_free = true;
-            size_t header_len = strlen("open2_sv6_zlib") + 1;
-            data = util_zlib_inflate(&chunk_buffer[header_len], size - header_len, &data_size);
-            if (data == nullptr)
-            {
-                log_warning("Failed to decompress data sent from server.");
+        if (!_mapReader->IsComplete()) {
+            log_warning("Map sent from server ended early.");
+            _mapReader = nullptr;
+            Close();
+            return;
+        }
+
+        std::unique_ptr<NetworkMapReader> mapReader = std::move(_mapReader);
+        std::vector<uint8> data;
+        if (mapReader->IsDelta()) {
+            if (!NetworkMapDelta::Apply(_mapKeyframe, mapReader->GetData(), data)) {
+                log_warning("Failed to apply the changes sent from server to the last map.");
                 Close();
                 return;
             }
         } else {
-            log_verbose("Assuming received map is in plain sv6 format");
+            data = std::move(mapReader->GetData());
         }
-
-        auto ms = MemoryStream(data, data_size);
+        auto ms = MemoryStream(data.data(), data.size());
         if (LoadMap(&ms))
         {
             game_load_init();
@@ -1870,16 +1878,16 @@ void Network::Client_Handle_MAP(NetworkConnection& connection, NetworkPacket& pa
 
             // Fix invalid vehicle sprite sizes, thus preventing visual corruption of sprites
             fix_invalid_vehicle_sprite_sizes();
+
+            // Keep the map for when we reconnect
+            _mapKeyframeHash = NetworkMapDelta::Hash(data);
+            _mapKeyframe = std::move(data);
         }
         else
         {
             //Something went wrong, game is not loaded. Return to main screen.
             game_do_command(0, GAME_COMMAND_FLAG_APPLY, 0, 0, GAME_COMMAND_LOAD_OR_QUIT, 1, 0);
         }
-        if (has_to_free)
-        {
-            free(data);
-        }
     }
 }
 
@@ -1901,6 +1909,7 @@ bool Network::LoadMap(IStream * stream)
 
         // Read other data not in normal save files
         stream->Read(gSpriteSpatialIndex, 0x10001 * sizeof(uint16));
+        sprite_spatial_index_rebuild();
         gGamePaused = stream->ReadValue<uint32>();
         _guestGenerationProbability = stream->ReadValue<uint32>();
         _suggestedGuestMaximum = stream->ReadValue<uint32>();
@@ -16,6 +16,7 @@
 
 #ifndef DISABLE_NETWORK
 
+#include <algorithm>
 #include "network.h"
 #include "NetworkConnection.h"
 #include "../core/String.hpp"
@@ -24,6 +25,7 @@
 #include "../platform/platform.h"
 
 constexpr size_t NETWORK_DISCONNECT_REASON_BUFFER_SIZE = 256;
+constexpr size_t MAP_MAX_QUEUED_CHUNKS = 4;
 
 NetworkConnection::NetworkConnection()
 {
@@ -91,20 +93,20 @@ sint32 NetworkConnection::ReadPacket()
 
 bool NetworkConnection::SendPacket(NetworkPacket& packet)
 {
+    // The data is shared by the copies of a packet queued for each client, so the size goes out as a separate
+    // buffer and BytesTransferred of each copy tracks how far that client got
     uint16 sizen = Convert::HostToNetwork(packet.Size);
-    std::vector<uint8> tosend;
-    tosend.reserve(sizeof(sizen) + packet.Size);
-    tosend.insert(tosend.end(), (uint8*)&sizen, (uint8*)&sizen + sizeof(sizen));
-    tosend.insert(tosend.end(), packet.Data->begin(), packet.Data->end());
-
-    const void * buffer = &tosend[packet.BytesTransferred];
-    size_t bufferSize = tosend.size() - packet.BytesTransferred;
-    size_t sent = Socket->SendData(buffer, bufferSize);
+    size_t totalSize = sizeof(sizen) + packet.Size;
+    size_t headerOffset = std::min(packet.BytesTransferred, sizeof(sizen));
+    size_t dataOffset = packet.BytesTransferred - headerOffset;
+
+    size_t sent = Socket->SendData((const uint8 *)&sizen + headerOffset, sizeof(sizen) - headerOffset,
+                                   packet.GetData() + dataOffset, packet.Size - dataOffset);
     if (sent > 0)
     {
         packet.BytesTransferred += sent;
     }
-    if (packet.BytesTransferred == tosend.size())
+    if (packet.BytesTransferred == totalSize)
     {
         return true;
     }
@@ -116,7 +118,14 @@ void NetworkConnection::QueuePacket(std::unique_ptr<NetworkPacket> packet, bool
     if (AuthStatus == NETWORK_AUTH_OK || !packet->CommandRequiresAuth())
     {
         packet->Size = (uint16)packet->Data->size();
-        if (front)
+        if (!front && !_pendingItems.empty())
+        {
+            // Keep the packet behind the map that is still being sent
+            PendingItem item;
+            item.Packet = std::move(packet);
+            _pendingItems.push_back(std::move(item));
+        }
+        else if (front)
         {
             // If the first packet was already partially sent add new packet to second position
             if (_outboundPackets.size() > 0 && _outboundPackets.front()->BytesTransferred > 0)
@@ -137,11 +146,60 @@ void NetworkConnection::QueuePacket(std::unique_ptr<NetworkPacket> packet, bool
     }
 }
 
+/**
+ * Queues a map that is being compressed. Its chunks are queued as they become available, and packets queued after the
+ * map wait until all of its chunks have been queued.
+ */
+void NetworkConnection::QueueMap(std::shared_ptr<NetworkMapStream> mapStream)
+{
+    // Like the MAP packets it is made of, the map is only sent to authenticated connections
+    if (AuthStatus != NETWORK_AUTH_OK)
+    {
+        return;
+    }
+
+    PendingItem item;
+    item.MapStream = mapStream;
+    _pendingItems.push_back(std::move(item));
+}
+
+void NetworkConnection::QueuePendingItems()
+{
+    while (!_pendingItems.empty())
+    {
+        PendingItem &item = _pendingItems.front();
+        if (item.MapStream != nullptr)
+        {
+            // Only keep a few chunks queued so a slow client does not hold the whole map in its queue
+            while (_outboundPackets.size() < MAP_MAX_QUEUED_CHUNKS)
+            {
+                std::unique_ptr<NetworkPacket> packet = item.MapStream->ReadChunk(item.MapOffset);
+                if (packet == nullptr)
+                {
+                    break;
+                }
+                packet->Size = (uint16)packet->Data->size();
+                _outboundPackets.push_back(std::move(packet));
+            }
+            if (!item.MapStream->IsComplete(item.MapOffset))
+            {
+                break;
+            }
+        }
+        else
+        {
+            _outboundPackets.push_back(std::move(item.Packet));
+        }
+        _pendingItems.pop_front();
+    }
+}
+
 void NetworkConnection::SendQueuedPackets()
 {
+    QueuePendingItems();
     while (_outboundPackets.size() > 0 && SendPacket(*(_outboundPackets.front()).get()))
     {
-        _outboundPackets.remove(_outboundPackets.front());
+        _outboundPackets.pop_front();
     }
 }
 
@@ -19,14 +19,17 @@
 #ifdef __cplusplus
 
 #ifndef DISABLE_NETWORK
+#include <deque>
 #include <list>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "../common.h"
 
 #include "NetworkTypes.h"
 #include "NetworkKey.h"
+#include "NetworkMapStream.h"
 #include "NetworkPacket.h"
 #include "TcpSocket.h"
 
@@ -44,12 +47,14 @@ public:
     NetworkKey                                  Key;
     std::vector<uint8>                          Challenge;
     std::vector<const ObjectRepositoryItem *>   RequestedObjects;
+    std::string                                 MapKeyframeHash;
 
     NetworkConnection();
     ~NetworkConnection();
 
     sint32  ReadPacket();
     void QueuePacket(std::unique_ptr<NetworkPacket> packet, bool front = false);
+    void QueueMap(std::shared_ptr<NetworkMapStream> mapStream);
     void SendQueuedPackets();
     void ResetLastPacketTime();
     bool ReceivedPacketRecently();
@@ -59,11 +64,20 @@ public:
     void SetLastDisconnectReason(const rct_string_id string_id, void * args = nullptr);
 
 private:
+    struct PendingItem
+    {
+        std::unique_ptr<NetworkPacket>      Packet;
+        std::shared_ptr<NetworkMapStream>   MapStream;
+        size_t                              MapOffset = 0;
+    };
+
     std::list<std::unique_ptr<NetworkPacket>>   _outboundPackets;
+    std::deque<PendingItem>                     _pendingItems;
     uint32                                      _lastPacketTime;
     utf8 *                                      _lastDisconnectReason   = nullptr;
 
     bool SendPacket(NetworkPacket &packet);
+    void QueuePendingItems();
 };
 
 #endif // DISABLE_NETWORK
@@ -0,0 +1,657 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#ifndef DISABLE_NETWORK
+
+#include <algorithm>
+#include <cstddef>
+#include <unordered_map>
+#include <openssl/evp.h>
+#include <zlib.h>
+#include "../core/Math.hpp"
+#include "NetworkMapStream.h"
+#include "NetworkTypes.h"
+
+#include "../platform/platform.h"
+#include "../scenario/scenario.h"
+#include "../util/sawyercoding.h"
+
+// Compressed maps start with one of these headers, including their null terminator, anything else is a plain sv6
+static constexpr char MAP_ZLIB_HEADER[] = "open2_sv6_zlib";
+static constexpr char MAP_DELTA_HEADER[] = "open2_sv6_diff";
+static_assert(sizeof(MAP_ZLIB_HEADER) == sizeof(MAP_DELTA_HEADER), "Map headers must be the same size");
+// Size of the blocks the parts of the parks that are not tiles, sprites or rides are compared in for a delta
+static constexpr size_t MAP_DELTA_BLOCK_SIZE = 64;
+// Amount of the park compressed at a time, the compressed data is published in between
+static constexpr size_t MAP_COMPRESS_SLICE_SIZE = 64 * 1024;
+
+NetworkMapStream::NetworkMapStream(std::shared_ptr<NetworkMapKeyframe> keyframe,
+                                   std::shared_ptr<const NetworkMapKeyframe> base)
+    : _keyframe(keyframe),
+      _base(base),
+      _outputSize(0),
+      _finished(false),
+      _cancelled(false)
+{
+    // Sized up front so the buffer never moves while the network thread reads what has been compressed so far. A delta
+    // is only sent when it is smaller than the park, so this fits either.
+    size_t dataSize = _keyframe->Data.size();
+    _output.resize(sizeof(MAP_ZLIB_HEADER) + Math::Max<size_t>(compressBound((uLong)dataSize), dataSize));
+    _thread = std::thread(&NetworkMapStream::Compress, this);
+}
+
+NetworkMapStream::~NetworkMapStream()
+{
+    _cancelled = true;
+    _thread.join();
+}
+
+std::unique_ptr<NetworkPacket> NetworkMapStream::ReadChunk(size_t &offset) const
+{
+    // Read whether the stream has finished before its size, so a finished stream's size is the final one
+    bool finished = _finished;
+    size_t outputSize = _outputSize;
+    if (offset >= outputSize || (!finished && outputSize - offset <= ChunkSize))
+    {
+        return nullptr;
+    }
+
+    // The total size is only known once compression has finished, until then it is sent as 0. The last bytes are
+    // held back until then, so the last chunk always carries the total size the client waits for.
+    size_t chunkSize = Math::Min(ChunkSize, outputSize - offset);
+    std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
+    *packet << (uint32)NETWORK_COMMAND_MAP << (uint32)(finished ? outputSize : 0) << (uint32)offset;
+    packet->Write(&_output[offset], chunkSize);
+    offset += chunkSize;
+    return packet;
+}
+
+bool NetworkMapStream::IsComplete(size_t offset) const
+{
+    return _finished && offset >= _outputSize;
+}
+
+void NetworkMapStream::Compress()
+{
+    uint32 startTime = platform_get_ticks();
+
+    // Hashed and compared here rather than when the park is saved, both take a while for a large park
+    _keyframe->Hash = NetworkMapDelta::Hash(_keyframe->Data);
+    _keyframe->Hashed = true;
+
+    const std::vector<uint8> * data = &_keyframe->Data;
+    std::vector<uint8> delta;
+    bool isDelta = false;
+    if (_base != nullptr)
+    {
+        delta = NetworkMapDelta::Create(_base->Data, _keyframe->Data);
+        if (delta.size() < _keyframe->Data.size() / 2)
+        {
+            log_verbose("Sending %u bytes of changes instead of a map of %u bytes",
+                        (uint32)delta.size(), (uint32)_keyframe->Data.size());
+            data = &delta;
+            isDelta = true;
+        }
+    }
+
+    z_stream zs = { 0 };
+    if (deflateInit(&zs, Z_DEFAULT_COMPRESSION) != Z_OK)
+    {
+        // Always the whole park, a delta can not be sent as a plain sv6
+        log_warning("Failed to compress the data, falling back to non-compressed sv6.");
+        std::copy(_keyframe->Data.begin(), _keyframe->Data.end(), _output.begin());
+        _outputSize = _keyframe->Data.size();
+        _keyframe = nullptr;
+        _base = nullptr;
+        _finished = true;
+        return;
+    }
+
+    const char * header = isDelta ? MAP_DELTA_HEADER : MAP_ZLIB_HEADER;
+    std::copy(header, header + sizeof(MAP_ZLIB_HEADER), _output.begin());
+    size_t outputSize = sizeof(MAP_ZLIB_HEADER);
+
+    size_t inputOffset = 0;
+    sint32 result = Z_OK;
+    while (result == Z_OK && !_cancelled)
+    {
+        size_t sliceSize = Math::Min(MAP_COMPRESS_SLICE_SIZE, data->size() - inputOffset);
+        zs.next_in = (Bytef *)data->data() + inputOffset;
+        zs.avail_in = (uInt)sliceSize;
+        zs.next_out = &_output[outputSize];
+        zs.avail_out = (uInt)(_output.size() - outputSize);
+        inputOffset += sliceSize;
+
+        result = deflate(&zs, inputOffset == data->size() ? Z_FINISH : Z_NO_FLUSH);
+        outputSize = _output.size() - zs.avail_out;
+        _outputSize = outputSize;
+    }
+    deflateEnd(&zs);
+
+    if (result == Z_STREAM_END)
+    {
+        log_verbose("Compressed map of size %u bytes to %u bytes in %u ms",
+                    (uint32)data->size(), (uint32)outputSize, platform_get_ticks() - startTime);
+    }
+    else if (!_cancelled)
+    {
+        log_error("Error compressing map data.");
+    }
+    // The keyframes stay with the server for as long as it keeps them
+    _keyframe = nullptr;
+    _base = nullptr;
+    _finished = true;
+}
+
+NetworkMapReader::NetworkMapReader()
+{
+}
+
+NetworkMapReader::~NetworkMapReader()
+{
+    if (_zstream != nullptr)
+    {
+        inflateEnd(_zstream.get());
+    }
+}
+
+bool NetworkMapReader::Append(const uint8 * data, size_t size)
+{
+    _receivedSize += size;
+    if (_state == State::Header)
+    {
+        size_t headerSize = Math::Min(sizeof(MAP_ZLIB_HEADER) - _header.size(), size);
+        _header.insert(_header.end(), data, data + headerSize);
+        data += headerSize;
+        size -= headerSize;
+        if (_header.size() < sizeof(MAP_ZLIB_HEADER))
+        {
+            return true;
+        }
+
+        _isDelta = memcmp(_header.data(), MAP_DELTA_HEADER, sizeof(MAP_DELTA_HEADER)) == 0;
+        if (_isDelta || memcmp(_header.data(), MAP_ZLIB_HEADER, sizeof(MAP_ZLIB_HEADER)) == 0)
+        {
+            log_verbose(_isDelta ? "Receiving changes to the last map" : "Receiving zlib-compressed sv6 map");
+            _zstream = std::unique_ptr<z_stream>(new z_stream());
+            if (inflateInit(_zstream.get()) != Z_OK)
+            {
+                _zstream = nullptr;
+                _state = State::Failed;
+                return false;
+            }
+            _state = State::Compressed;
+        }
+        else
+        {
+            log_verbose("Assuming received map is in plain sv6 format");
+            _data.insert(_data.end(), _header.begin(), _header.end());
+            _state = State::Raw;
+        }
+    }
+
+    switch (_state) {
+    case State::Raw:
+        _data.insert(_data.end(), data, data + size);
+        return true;
+    case State::Compressed:
+        return Inflate(data, size);
+    case State::Finished:
+        // Nothing is expected after the end of the compressed stream
+        return size == 0;
+    default:
+        return false;
+    }
+}
+
+bool NetworkMapReader::Inflate(const uint8 * data, size_t size)
+{
+    _zstream->next_in = (Bytef *)data;
+    _zstream->avail_in = (uInt)size;
+    while (_zstream->avail_in > 0)
+    {
+        if (_data.size() - _zstream->total_out < MAP_COMPRESS_SLICE_SIZE)
+        {
+            _data.resize(Math::Max<size_t>(_data.size() * 2, MAP_COMPRESS_SLICE_SIZE * 4));
+        }
+        _zstream->next_out = &_data[_zstream->total_out];
+        _zstream->avail_out = (uInt)(_data.size() - _zstream->total_out);
+
+        sint32 result = inflate(_zstream.get(), Z_NO_FLUSH);
+        if (result == Z_STREAM_END)
+        {
+            _data.resize(_zstream->total_out);
+            _state = State::Finished;
+            return _zstream->avail_in == 0;
+        }
+        if (result != Z_OK && result != Z_BUF_ERROR)
+        {
+            log_error("Error uncompressing map data.");
+            _state = State::Failed;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool NetworkMapReader::IsComplete() const
+{
+    return _state == State::Raw || _state == State::Finished;
+}
+
+bool NetworkMapReader::IsDelta() const
+{
+    return _isDelta;
+}
+
+size_t NetworkMapReader::GetReceivedSize() const
+{
+    return _receivedSize;
+}
+
+std::vector<uint8> &NetworkMapReader::GetData()
+{
+    return _data;
+}
+
+static void WriteUInt32(std::vector<uint8> &buffer, uint32 value)
+{
+    for (sint32 i = 0; i < 4; i++)
+    {
+        buffer.push_back((uint8)(value >> (i * 8)));
+    }
+}
+
+static bool ReadUInt32(const std::vector<uint8> &buffer, size_t &offset, uint32 * value)
+{
+    if (offset > buffer.size() || buffer.size() - offset < 4)
+    {
+        return false;
+    }
+    *value = 0;
+    for (sint32 i = 0; i < 4; i++)
+    {
+        *value |= (uint32)buffer[offset++] << (i * 8);
+    }
+    return true;
+}
+
+namespace NetworkMapDelta
+{
+    enum class Operation : uint8
+    {
+        // Bytes of the base park, from an offset in the base park
+        Copy,
+        // New bytes, held in the delta
+        Data,
+    };
+
+    enum class Section : uint8
+    {
+        Whole,
+        BeforeMapElements,
+        Tiles,
+        AfterTiles,
+        BeforeSprites,
+        Sprites,
+        BeforeRides,
+        Rides,
+        AfterRides,
+        AfterExtraTiles,
+        Checksum,
+    };
+
+    /**
+     * A part of a saved park, compared with the part of the other park that has the same key: the map elements of a
+     * tile, a sprite, a ride or a block of the bytes around them.
+     */
+    struct Unit
+    {
+        uint64 Key;
+        size_t Offset;
+        size_t Length;
+    };
+
+    static uint64 GetKey(Section section, uint64 index)
+    {
+        return ((uint64)section << 56) | index;
+    }
+
+    /**
+     * Adds the bytes from start to end as records of the given size, numbered from the origin. Both parks number the
+     * records from the same place in their layout, so the records line up even when the parts before them differ.
+     */
+    static void AddRecords(std::vector<Unit> &units, Section section, size_t origin, size_t start, size_t end,
+                           size_t recordSize)
+    {
+        size_t offset = start;
+        while (offset < end)
+        {
+            size_t index = (offset - origin) / recordSize;
+            size_t recordEnd = Math::Min(origin + (index + 1) * recordSize, end);
+            units.push_back({ GetKey(section, index), offset, recordEnd - offset });
+            offset = recordEnd;
+        }
+    }
+
+    static bool ReadChunkHeader(const std::vector<uint8> &park, size_t &offset, sawyercoding_chunk_header * header,
+                                size_t * dataOffset)
+    {
+        if (offset > park.size() || park.size() - offset < sizeof(sawyercoding_chunk_header))
+        {
+            return false;
+        }
+        memcpy(header, &park[offset], sizeof(sawyercoding_chunk_header));
+        offset += sizeof(sawyercoding_chunk_header);
+        if (park.size() - offset < header->length)
+        {
+            return false;
+        }
+        *dataOffset = offset;
+        offset += header->length;
+        return true;
+    }
+
+    /**
+     * Splits a saved game written for the network, which has no run length encoded chunks, into the units it is
+     * compared in. The elements of a tile make up one unit, or two when the tile goes on in the extra map elements
+     * chunk. Returns false if the park is laid out in any other way.
+     */
+    static bool GetParkUnits(const std::vector<uint8> &park, std::vector<Unit> &units)
+    {
+        size_t offset = 0;
+        sawyercoding_chunk_header chunkHeader;
+        size_t dataOffset;
+
+        rct_s6_header s6Header;
+        if (!ReadChunkHeader(park, offset, &chunkHeader, &dataOffset) || chunkHeader.length != sizeof(s6Header))
+        {
+            return false;
+        }
+        sawyercoding_read_chunk_buffer((uint8 *)&s6Header, &park[dataOffset], chunkHeader, sizeof(s6Header));
+        if (s6Header.type != S6_TYPE_SAVEDGAME)
+        {
+            return false;
+        }
+        for (uint16 i = 0; i < s6Header.num_packed_objects; i++)
+        {
+            offset += sizeof(rct_object_entry);
+            if (!ReadChunkHeader(park, offset, &chunkHeader, &dataOffset))
+            {
+                return false;
+            }
+        }
+        // Available objects and the misc fields
+        for (sint32 i = 0; i < 2; i++)
+        {
+            if (!ReadChunkHeader(park, offset, &chunkHeader, &dataOffset))
+            {
+                return false;
+            }
+        }
+
+        const rct_s6_data * s6 = nullptr;
+        size_t mapElementsStart;
+        if (!ReadChunkHeader(park, offset, &chunkHeader, &mapElementsStart) ||
+            chunkHeader.encoding != CHUNK_ENCODING_NONE || chunkHeader.length != sizeof(s6->map_elements))
+        {
+            return false;
+        }
+        size_t mapElementsEnd = offset;
+
+        size_t everythingElseStart;
+        if (!ReadChunkHeader(park, offset, &chunkHeader, &everythingElseStart) ||
+            chunkHeader.encoding != CHUNK_ENCODING_NONE)
+        {
+            return false;
+        }
+        size_t everythingElseEnd = offset;
+        size_t spritesStart = everythingElseStart + offsetof(rct_s6_data, sprites) -
+                              offsetof(rct_s6_data, next_free_map_element_pointer_index);
+        size_t spritesEnd = spritesStart + sizeof(s6->sprites);
+        size_t ridesStart = everythingElseStart + offsetof(rct_s6_data, rides) -
+                            offsetof(rct_s6_data, next_free_map_element_pointer_index);
+        size_t ridesEnd = ridesStart + sizeof(s6->rides);
+        if (ridesEnd > everythingElseEnd)
+        {
+            return false;
+        }
+
+        size_t numExtraMapElements = s6Header.num_extra_map_elements;
+        size_t mapElementsUsedEnd = mapElementsEnd;
+        size_t extraMapElementsStart = park.size();
+        size_t extraMapElementsEnd = park.size();
+        if (numExtraMapElements > 0)
+        {
+            mapElementsUsedEnd = mapElementsStart + MAX_MAP_ELEMENTS * sizeof(rct_map_element);
+            if (!ReadChunkHeader(park, offset, &chunkHeader, &extraMapElementsStart) ||
+                chunkHeader.encoding != CHUNK_ENCODING_NONE ||
+                chunkHeader.length != numExtraMapElements * sizeof(rct_map_element))
+            {
+                return false;
+            }
+            extraMapElementsEnd = offset;
+        }
+
+        // The tiles are in the same order in every park, so the elements of a tile are compared with the elements of
+        // the same tile wherever they are
+        size_t elementOffset = mapElementsStart;
+        size_t segmentEnd = mapElementsUsedEnd;
+        bool inExtraMapElements = false;
+        for (uint32 tileIndex = 0; tileIndex < MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL; tileIndex++)
+        {
+            size_t tileStart = elementOffset;
+            bool isLastElement = false;
+            while (!isLastElement)
+            {
+                if (elementOffset == segmentEnd)
+                {
+                    if (inExtraMapElements || numExtraMapElements == 0)
+                    {
+                        return false;
+                    }
+                    if (elementOffset != tileStart)
+                    {
+                        units.push_back({ GetKey(Section::Tiles, tileIndex * 2), tileStart, elementOffset - tileStart });
+                    }
+                    elementOffset = extraMapElementsStart;
+                    tileStart = elementOffset;
+                    segmentEnd = extraMapElementsEnd;
+                    inExtraMapElements = true;
+                }
+                const rct_map_element * mapElement = (const rct_map_element *)&park[elementOffset];
+                isLastElement = (mapElement->flags & MAP_ELEMENT_FLAG_LAST_TILE) != 0;
+                elementOffset += sizeof(rct_map_element);
+            }
+            units.push_back({ GetKey(Section::Tiles, tileIndex * 2 + (inExtraMapElements ? 1 : 0)), tileStart,
+                              elementOffset - tileStart });
+        }
+        size_t tilesEnd = inExtraMapElements ? mapElementsUsedEnd : elementOffset;
+        size_t extraTilesEnd = inExtraMapElements ? elementOffset : extraMapElementsStart;
+
+        AddRecords(units, Section::BeforeMapElements, 0, 0, mapElementsStart, MAP_DELTA_BLOCK_SIZE);
+        AddRecords(units, Section::AfterTiles, mapElementsStart, tilesEnd, mapElementsEnd, MAP_DELTA_BLOCK_SIZE);
+        AddRecords(units, Section::BeforeSprites, mapElementsEnd, mapElementsEnd, spritesStart, MAP_DELTA_BLOCK_SIZE);
+        AddRecords(units, Section::Sprites, spritesStart, spritesStart, spritesEnd, sizeof(s6->sprites[0]));
+        AddRecords(units, Section::BeforeRides, spritesEnd, spritesEnd, ridesStart, MAP_DELTA_BLOCK_SIZE);
+        AddRecords(units, Section::Rides, ridesStart, ridesStart, ridesEnd, sizeof(s6->rides[0]));
+        AddRecords(units, Section::AfterRides, ridesEnd, ridesEnd, extraMapElementsStart, MAP_DELTA_BLOCK_SIZE);
+        AddRecords(units, Section::AfterExtraTiles, extraMapElementsStart, extraTilesEnd, extraMapElementsEnd,
+                   MAP_DELTA_BLOCK_SIZE);
+        AddRecords(units, Section::Checksum, extraMapElementsEnd, extraMapElementsEnd, park.size(), MAP_DELTA_BLOCK_SIZE);
+
+        std::sort(units.begin(), units.end(), [](const Unit &a, const Unit &b) -> bool
+        {
+            return a.Offset < b.Offset;
+        });
+        return true;
+    }
+
+    /**
+     * Splits a park into its units, or into blocks if it is not laid out like a saved game written for the network.
+     */
+    static std::vector<Unit> GetUnits(const std::vector<uint8> &park)
+    {
+        std::vector<Unit> units;
+        if (!GetParkUnits(park, units))
+        {
+            units.clear();
+            AddRecords(units, Section::Whole, 0, 0, park.size(), MAP_DELTA_BLOCK_SIZE);
+        }
+        return units;
+    }
+
+    std::string Hash(const std::vector<uint8> &data)
+    {
+        // A context of its own, this runs on the threads of the map streams
+        EVP_MD_CTX * ctx = EVP_MD_CTX_create();
+        uint8 hash[EVP_MAX_MD_SIZE];
+        uint32 size = sizeof(hash);
+        if (ctx == nullptr ||
+            EVP_DigestInit_ex(ctx, EVP_sha1(), nullptr) <= 0 ||
+            EVP_DigestUpdate(ctx, data.data(), data.size()) <= 0 ||
+            EVP_DigestFinal_ex(ctx, hash, &size) <= 0)
+        {
+            log_error("Failed to hash map data");
+            if (ctx != nullptr)
+            {
+                EVP_MD_CTX_destroy(ctx);
+            }
+            return std::string();
+        }
+        EVP_MD_CTX_destroy(ctx);
+
+        std::string result;
+        for (uint32 i = 0; i < size; i++)
+        {
+            char hex[3];
+            snprintf(hex, sizeof(hex), "%02x", hash[i]);
+            result += hex;
+        }
+        return result;
+    }
+
+    /**
+     * The delta holds the sizes of both parks, then the operations that make up the new park in order: copies of the
+     * parts of the old park that did not change, wherever they are in it, and the bytes of the parts that did. A copy
+     * is its offset in the old park and its length, new bytes are their length followed by the bytes.
+     */
+    std::vector<uint8> Create(const std::vector<uint8> &base, const std::vector<uint8> &target)
+    {
+        std::vector<Unit> baseUnits = GetUnits(base);
+        std::unordered_map<uint64, const Unit *> baseUnitsByKey;
+        baseUnitsByKey.reserve(baseUnits.size());
+        for (const auto &unit : baseUnits)
+        {
+            baseUnitsByKey[unit.Key] = &unit;
+        }
+
+        std::vector<uint8> delta;
+        WriteUInt32(delta, (uint32)base.size());
+        WriteUInt32(delta, (uint32)target.size());
+
+        Operation operation = Operation::Copy;
+        size_t operationStart = 0;
+        size_t operationLength = 0;
+        auto writeOperation = [&]() -> void
+        {
+            if (operationLength == 0)
+            {
+                return;
+            }
+            delta.push_back((uint8)operation);
+            if (operation == Operation::Copy)
+            {
+                WriteUInt32(delta, (uint32)operationStart);
+            }
+            WriteUInt32(delta, (uint32)operationLength);
+            if (operation == Operation::Data)
+            {
+                delta.insert(delta.end(), target.begin() + operationStart, target.begin() + operationStart + operationLength);
+            }
+            operationLength = 0;
+        };
+
+        for (const auto &unit : GetUnits(target))
+        {
+            auto it = baseUnitsByKey.find(unit.Key);
+            const Unit * baseUnit = it != baseUnitsByKey.end() ? it->second : nullptr;
+            bool unchanged = baseUnit != nullptr && baseUnit->Length == unit.Length &&
+                             memcmp(&base[baseUnit->Offset], &target[unit.Offset], unit.Length) == 0;
+
+            // A copy starts at an offset of the base park, new bytes at an offset of the new park
+            Operation unitOperation = unchanged ? Operation::Copy : Operation::Data;
+            size_t unitStart = unchanged ? baseUnit->Offset : unit.Offset;
+            if (operationLength == 0 || unitOperation != operation || unitStart != operationStart + operationLength)
+            {
+                writeOperation();
+                operation = unitOperation;
+                operationStart = unitStart;
+            }
+            operationLength += unit.Length;
+        }
+        writeOperation();
+        return delta;
+    }
+
+    bool Apply(const std::vector<uint8> &base, const std::vector<uint8> &delta, std::vector<uint8> &target)
+    {
+        size_t offset = 0;
+        uint32 baseSize, targetSize;
+        if (!ReadUInt32(delta, offset, &baseSize) || !ReadUInt32(delta, offset, &targetSize) || baseSize != base.size())
+        {
+            return false;
+        }
+
+        target.clear();
+        target.reserve(targetSize);
+        while (offset < delta.size())
+        {
+            Operation operation = (Operation)delta[offset++];
+            uint32 start = 0;
+            uint32 length;
+            if ((operation == Operation::Copy && !ReadUInt32(delta, offset, &start)) ||
+                !ReadUInt32(delta, offset, &length) || length > targetSize - target.size())
+            {
+                return false;
+            }
+            if (operation == Operation::Copy)
+            {
+                if (start > base.size() || length > base.size() - start)
+                {
+                    return false;
+                }
+                target.insert(target.end(), base.begin() + start, base.begin() + start + length);
+            }
+            else if (operation == Operation::Data)
+            {
+                if (length > delta.size() - offset)
+                {
+                    return false;
+                }
+                target.insert(target.end(), delta.begin() + offset, delta.begin() + offset + length);
+                offset += length;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return target.size() == targetSize;
+    }
+}
+
+#endif // DISABLE_NETWORK
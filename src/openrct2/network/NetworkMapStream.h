@@ -0,0 +1,125 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#ifdef __cplusplus
+
+#ifndef DISABLE_NETWORK
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../common.h"
+#include "NetworkPacket.h"
+
+typedef struct z_stream_s z_stream;
+
+/**
+ * A park saved for clients, kept so a client that has it can later be sent only what has changed since. Its hash is
+ * worked out by the stream that sends it, the data does not change once the stream has been created.
+ */
+struct NetworkMapKeyframe
+{
+    std::vector<uint8>  Data;
+    std::string         Hash;
+    std::atomic<bool>   Hashed { false };
+};
+
+/**
+ * Compresses a park saved for a joining client on a background thread. The compressed data can be read while it is
+ * being produced, so the server sends the first chunks of the map while the rest is still being compressed. When a
+ * base is given, the park is sent as the changes to the base if that is much smaller.
+ */
+class NetworkMapStream final
+{
+public:
+    static constexpr size_t ChunkSize = 65000;
+
+    explicit NetworkMapStream(std::shared_ptr<NetworkMapKeyframe> keyframe,
+                              std::shared_ptr<const NetworkMapKeyframe> base = nullptr);
+    ~NetworkMapStream();
+
+    /**
+     * Creates the MAP packet for the data at the given offset and advances the offset, or returns nullptr when there is
+     * not enough compressed data for a full chunk yet.
+     */
+    std::unique_ptr<NetworkPacket> ReadChunk(size_t &offset) const;
+    bool IsComplete(size_t offset) const;
+
+private:
+    std::shared_ptr<NetworkMapKeyframe>         _keyframe;
+    std::shared_ptr<const NetworkMapKeyframe>   _base;
+    std::vector<uint8>  _output;
+    std::atomic<size_t> _outputSize;
+    std::atomic<bool>   _finished;
+    std::atomic<bool>   _cancelled;
+    std::thread         _thread;
+
+    void Compress();
+};
+
+/**
+ * Receives the chunks of a map on the client, inflating them as they arrive.
+ */
+class NetworkMapReader final
+{
+public:
+    NetworkMapReader();
+    ~NetworkMapReader();
+
+    bool Append(const uint8 * data, size_t size);
+    bool IsComplete() const;
+    bool IsDelta() const;
+    size_t GetReceivedSize() const;
+    std::vector<uint8> &GetData();
+
+private:
+    enum class State
+    {
+        Header,
+        Raw,
+        Compressed,
+        Finished,
+        Failed,
+    };
+
+    State                       _state = State::Header;
+    bool                        _isDelta = false;
+    std::vector<uint8>          _header;
+    std::unique_ptr<z_stream>   _zstream;
+    std::vector<uint8>          _data;
+    size_t                      _receivedSize = 0;
+
+    bool Inflate(const uint8 * data, size_t size);
+};
+
+/**
+ * Differences between two saved parks, sent instead of the whole park to a client that still has the older one. The
+ * parks are compared tile by tile, sprite by sprite and ride by ride, so a changed tile, sprite or ride only costs
+ * itself, even when the map elements of the tiles after it have moved.
+ */
+namespace NetworkMapDelta
+{
+    std::string Hash(const std::vector<uint8> &data);
+    std::vector<uint8> Create(const std::vector<uint8> &base, const std::vector<uint8> &target);
+    bool Apply(const std::vector<uint8> &base, const std::vector<uint8> &delta, std::vector<uint8> &target);
+}
+
+#endif // DISABLE_NETWORK
+#endif
@@ -24,6 +24,9 @@ std::unique_ptr<NetworkPacket> NetworkPacket::Allocate()
     return std::unique_ptr<NetworkPacket>(new NetworkPacket); // change to make_unique in c++14
 }
 
+/**
+ * Copies the packet for sending to another connection, the data itself is shared and not copied.
+ */
 std::unique_ptr<NetworkPacket> NetworkPacket::Duplicate(NetworkPacket &packet)
 {
     return std::unique_ptr<NetworkPacket>(new NetworkPacket(packet)); // change to make_unique in c++14
@@ -46,6 +46,7 @@
     #include <netinet/tcp.h>
     #include <netinet/in.h>
     #include <sys/socket.h>
+    #include <sys/uio.h>
     #include <fcntl.h>
     #include "../common.h"
     typedef sint32 SOCKET;
@@ -375,6 +376,57 @@ public:
         return totalSent;
     }
 
+    /**
+     * Sends a header followed by a buffer in one call without joining them first, returns the number of bytes of
+     * both that were sent.
+     */
+    size_t SendData(const void * header, size_t headerSize, const void * buffer, size_t size) override
+    {
+        if (_status != SOCKET_STATUS_CONNECTED)
+        {
+            throw Exception("Socket not connected.");
+        }
+
+        size_t totalSize = headerSize + size;
+        size_t totalSent = 0;
+        do
+        {
+            size_t headerSent = totalSent < headerSize ? totalSent : headerSize;
+            const char * headerStart = (const char *)header + headerSent;
+            size_t headerRemaining = headerSize - headerSent;
+            const char * bufferStart = (const char *)buffer + (totalSent - headerSent);
+            size_t bufferRemaining = size - (totalSent - headerSent);
+#ifdef _WIN32
+            WSABUF buffers[2];
+            buffers[0].buf = (CHAR *)headerStart;
+            buffers[0].len = (ULONG)headerRemaining;
+            buffers[1].buf = (CHAR *)bufferStart;
+            buffers[1].len = (ULONG)bufferRemaining;
+            DWORD sentBytes = 0;
+            if (WSASend(_socket, buffers, 2, &sentBytes, 0, nullptr, nullptr) == SOCKET_ERROR)
+            {
+                return totalSent;
+            }
+#else
+            iovec buffers[2];
+            buffers[0].iov_base = (void *)headerStart;
+            buffers[0].iov_len = headerRemaining;
+            buffers[1].iov_base = (void *)bufferStart;
+            buffers[1].iov_len = bufferRemaining;
+            msghdr message = { 0 };
+            message.msg_iov = buffers;
+            message.msg_iovlen = 2;
+            ssize_t sentBytes = sendmsg(_socket, &message, FLAG_NO_PIPE);
+            if (sentBytes == SOCKET_ERROR)
+            {
+                return totalSent;
+            }
+#endif
+            totalSent += (size_t)sentBytes;
+        } while (totalSent < totalSize);
+        return totalSent;
+    }
+
     NETWORK_READPACKET ReceiveData(void * buffer, size_t size, size_t * sizeReceived) override
     {
         if (_status != SOCKET_STATUS_CONNECTED)
@@ -57,6 +57,8 @@ public:
     virtual void ConnectAsync(const char * address, uint16 port) abstract;
 
     virtual size_t             SendData(const void * buffer, size_t size)                     abstract;
+    virtual size_t             SendData(const void * header, size_t headerSize,
+                                        const void * buffer, size_t size)                     abstract;
     virtual NETWORK_READPACKET ReceiveData(void * buffer, size_t size, size_t * sizeReceived) abstract;
 
     virtual void Disconnect() abstract;
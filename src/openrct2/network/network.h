@@ -49,12 +49,13 @@ enum {
 // This define specifies which version of network stream current build uses.
 // It is used for making sure only compatible builds get connected, even within
 // single OpenRCT2 version.
-#define NETWORK_STREAM_VERSION "3"
+#define NETWORK_STREAM_VERSION "7"
 #define NETWORK_STREAM_ID OPENRCT2_VERSION "-" NETWORK_STREAM_VERSION
 
 #ifdef __cplusplus
 
 #include <array>
+#include <deque>
 #include <list>
 #include <set>
 #include <memory>
@@ -67,6 +68,7 @@ enum {
 #include "NetworkConnection.h"
 #include "NetworkGroup.h"
 #include "NetworkKey.h"
+#include "NetworkMapStream.h"
 #include "NetworkPacket.h"
 #include "NetworkPlayer.h"
 #include "NetworkServerAdvertiser.h"
@@ -217,7 +219,10 @@ private:
     uint8 player_id = 0;
     std::list<std::unique_ptr<NetworkConnection>> client_connection_list;
     std::multiset<GameCommand> game_command_queue;
-    std::vector<uint8> chunk_buffer;
+    std::unique_ptr<NetworkMapReader> _mapReader;
+    std::vector<uint8> _mapKeyframe;
+    std::string _mapKeyframeHash;
+    std::deque<std::shared_ptr<NetworkMapKeyframe>> _mapKeyframes;
     std::string _password;
     bool _desynchronised = false;
     INetworkServerAdvertiser * _advertiser = nullptr;
@@ -260,7 +265,7 @@ private:
     void Client_Handle_OBJECTS(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_OBJECTS(NetworkConnection& connection, NetworkPacket& packet);
 
-    uint8 * save_for_network(size_t &out_size, const std::vector<const ObjectRepositoryItem *> &objects) const;
+    bool save_for_network(std::vector<uint8> &data, const std::vector<const ObjectRepositoryItem *> &objects) const;
 };
 
 #endif // __cplusplus
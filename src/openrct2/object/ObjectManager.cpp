@@ -16,8 +16,10 @@
 
 #include <array>
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 #include "../core/Console.hpp"
+#include "../core/JobPool.hpp"
 #include "../core/Memory.hpp"
 #include "../localisation/string_ids.h"
 #include "FootpathItemObject.h"
@@ -529,6 +531,9 @@ private:
 
     Object * * LoadObjects(const ObjectRepositoryItem * * requiredObjects, size_t * outNewObjectsLoaded)
     {
+        // Read all the new objects first, then load and register them in slot order
+        auto readObjects = ReadObjects(requiredObjects);
+
         size_t newObjectsLoaded = 0;
         Object * * loadedObjects = Memory::AllocateArray<Object *>(OBJECT_ENTRY_COUNT);
         for (sint32 i = 0; i < OBJECT_ENTRY_COUNT; i++)
@@ -540,13 +545,21 @@ private:
                 loadedObject = ori->LoadedObject;
                 if (loadedObject == nullptr)
                 {
-                    loadedObject = GetOrLoadObject(ori);
+                    loadedObject = readObjects[ori];
                     if (loadedObject == nullptr)
                     {
                         ReportObjectLoadProblem(&ori->ObjectEntry);
+                        for (const auto &kvp : readObjects)
+                        {
+                            if (kvp.first->LoadedObject != kvp.second)
+                            {
+                                delete kvp.second;
+                            }
+                        }
                         Memory::Free(loadedObjects);
                         return nullptr;
                     } else {
+                        RegisterObject(ori, loadedObject);
                         newObjectsLoaded++;
                     }
                 }
@@ -560,6 +573,45 @@ private:
         return loadedObjects;
     }
 
+    /**
+     * Reads the required objects that are not loaded yet from their files on all cores. Reading an object only
+     * decodes the file into the object itself, allocating its images and registering it is left to the caller.
+     */
+    std::unordered_map<const ObjectRepositoryItem *, Object *> ReadObjects(const ObjectRepositoryItem * * requiredObjects)
+    {
+        // The same object can be required by more than one slot, read it once
+        std::vector<const ObjectRepositoryItem *> objectsToRead;
+        auto seen = std::unordered_set<const ObjectRepositoryItem *>();
+        for (sint32 i = 0; i < OBJECT_ENTRY_COUNT; i++)
+        {
+            const ObjectRepositoryItem * ori = requiredObjects[i];
+            if (ori != nullptr && ori->LoadedObject == nullptr && seen.insert(ori).second)
+            {
+                objectsToRead.push_back(ori);
+            }
+        }
+
+        std::vector<Object *> objects(objectsToRead.size());
+        {
+            JobPool jobPool;
+            for (size_t i = 0; i < objectsToRead.size(); i++)
+            {
+                jobPool.AddTask([this, &objectsToRead, &objects, i]() -> void
+                {
+                    objects[i] = _objectRepository->LoadObject(objectsToRead[i]);
+                });
+            }
+            jobPool.Join();
+        }
+
+        std::unordered_map<const ObjectRepositoryItem *, Object *> readObjects;
+        for (size_t i = 0; i < objectsToRead.size(); i++)
+        {
+            readObjects[objectsToRead[i]] = objects[i];
+        }
+        return readObjects;
+    }
+
     Object * GetOrLoadObject(const ObjectRepositoryItem * ori)
     {
         Object * loadedObject = ori->LoadedObject;
@@ -569,15 +621,20 @@ private:
             loadedObject = _objectRepository->LoadObject(ori);
             if (loadedObject != nullptr)
             {
-                loadedObject->Load();
-
-                // Connect the ori to the registered object
-                _objectRepository->RegisterLoadedObject(ori, loadedObject);
+                RegisterObject(ori, loadedObject);
             }
         }
         return loadedObject;
     }
 
+    void RegisterObject(const ObjectRepositoryItem * ori, Object * loadedObject)
+    {
+        loadedObject->Load();
+
+        // Connect the ori to the registered object
+        _objectRepository->RegisterLoadedObject(ori, loadedObject);
+    }
+
     static void ReportMissingObject(const rct_object_entry * entry)
     {
         utf8 objName[9] = { 0 };
@@ -605,7 +605,7 @@ private:
         auto chunk = chunkReader.ReadChunk();
 
         // Write object data to stream
-        auto chunkWriter = SawyerChunkWriter(stream);
+        SawyerChunkWriter chunkWriter(stream);
         stream->WriteValue(*entry);
         chunkWriter.WriteChunk(chunk.get());
     }
@@ -0,0 +1,97 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include "../core/JobPool.hpp"
+#include "../core/Math.hpp"
+
+#include "../config/Config.h"
+#include "../drawing/drawing.h"
+#include "../drawing/lightfx.h"
+#include "../drawing/NewDrawing.h"
+#include "paint.h"
+
+// Each worker allocates one paint session at a time, so never run more workers than there are sessions
+static std::unique_ptr<JobPool> _paintJobs;
+static std::mutex               _paintSharedStateMutex;
+
+static JobPool * paint_jobs_get_pool()
+{
+    if (_paintJobs == nullptr)
+    {
+        _paintJobs = std::unique_ptr<JobPool>(new JobPool(MAX_PAINT_SESSIONS));
+    }
+    return _paintJobs.get();
+}
+
+extern "C"
+{
+    bool paint_jobs_enabled()
+    {
+        if (!gConfigGeneral.multithreading)
+        {
+            return false;
+        }
+#ifdef __ENABLE_LIGHTFX__
+        // Lights are collected into a single list while the viewport is being painted
+        if (lightfx_is_available())
+        {
+            return false;
+        }
+#endif
+        return drawing_engine_has_parallel_drawing();
+    }
+
+    /**
+     * Calls callback once for every index in [0, count) on the paint worker threads and waits for all of them
+     * to finish. Indices are handed out in order, so neighbouring columns tend to be painted at the same time.
+     */
+    void paint_jobs_run(paint_job_callback callback, sint32 count, void * arg)
+    {
+        if (count <= 0)
+        {
+            return;
+        }
+
+        JobPool * jobPool = paint_jobs_get_pool();
+        std::atomic<sint32> nextIndex(0);
+        size_t numTasks = Math::Min((size_t)count, jobPool->GetThreadCount());
+        for (size_t i = 0; i < numTasks; i++)
+        {
+            jobPool->AddTask([&nextIndex, callback, count, arg]() -> void
+            {
+                sint32 index;
+                while ((index = nextIndex++) < count)
+                {
+                    callback(index, arg);
+                }
+            });
+        }
+        jobPool->Join();
+    }
+
+    void paint_shared_state_lock()
+    {
+        _paintSharedStateMutex.lock();
+    }
+
+    void paint_shared_state_unlock()
+    {
+        _paintSharedStateMutex.unlock();
+    }
+}
@@ -93,6 +93,9 @@ void banner_paint(paint_session * session, uint8 direction, sint32 height, rct_m
 
     scrollingMode += direction;
 
+    // Format arguments, fonts and the scrolling text cache are shared with other paint threads
+    paint_shared_state_lock();
+
     set_format_arg(0, uint32, 0);
     set_format_arg(4, uint32, 0);
 
@@ -113,5 +116,8 @@ void banner_paint(paint_session * session, uint8 direction, sint32 height, rct_m
     uint16 string_width = gfx_get_string_width(gCommonStringFormatBuffer);
     uint16 scroll = (gCurrentTicks / 2) % string_width;
 
-    sub_98199C(session, scrolling_text_setup(session, string_id, scroll, scrollingMode), 0, 0, 1, 1, 0x15, height + 22, boundBoxOffsetX, boundBoxOffsetY, boundBoxOffsetZ, get_current_rotation());
+    uint32 scrollingTextImageId = scrolling_text_setup(session, string_id, scroll, scrollingMode);
+    paint_shared_state_unlock();
+
+    sub_98199C(session, scrollingTextImageId, 0, 0, 1, 1, 0x15, height + 22, boundBoxOffsetX, boundBoxOffsetY, boundBoxOffsetZ, get_current_rotation());
 }
@@ -26,8 +26,6 @@
 #include "map_element.h"
 #include "../../drawing/lightfx.h"
 
-static uint32 _unk9E32BC;
-
 /**
  *
  *  rct2: 0x0066508C, 0x00665540
@@ -82,12 +80,12 @@ static void ride_entrance_exit_paint(paint_session * session, uint8 direction, s
     image_id = (colour_1 << 19) | (colour_2 << 24) | IMAGE_TYPE_REMAP | IMAGE_TYPE_REMAP_2_PLUS;
 
     session->InteractionType = VIEWPORT_INTERACTION_ITEM_RIDE;
-    _unk9E32BC = 0;
+    session->Unk9E32BC = 0;
 
     if (map_element->flags & MAP_ELEMENT_FLAG_GHOST){
         session->InteractionType = VIEWPORT_INTERACTION_ITEM_NONE;
         image_id = construction_markers[gConfigGeneral.construction_marker_colour];
-        _unk9E32BC = image_id;
+        session->Unk9E32BC = image_id;
         if (transparant_image_id)
             transparant_image_id = image_id;
     }
@@ -140,6 +138,9 @@ static void ride_entrance_exit_paint(paint_session * session, uint8 direction, s
         !(map_element->flags & MAP_ELEMENT_FLAG_GHOST) &&
         map_element->properties.entrance.ride_index != 0xFF){
 
+        // Format arguments, fonts and the scrolling text cache are shared with other paint threads
+        paint_shared_state_lock();
+
         set_format_arg(0, uint32, 0);
         set_format_arg(4, uint32, 0);
 
@@ -166,10 +167,13 @@ static void ride_entrance_exit_paint(paint_session * session, uint8 direction, s
         uint16 string_width = gfx_get_string_width(entrance_string);
         uint16 scroll = (gCurrentTicks / 2) % string_width;
 
-        sub_98199C(session, scrolling_text_setup(session, string_id, scroll, style->scrolling_mode), 0, 0, 0x1C, 0x1C, 0x33, height + style->height, 2, 2, height + style->height, get_current_rotation());
+        uint32 scrollingTextImageId = scrolling_text_setup(session, string_id, scroll, style->scrolling_mode);
+        paint_shared_state_unlock();
+
+        sub_98199C(session, scrollingTextImageId, 0, 0, 0x1C, 0x1C, 0x33, height + style->height, 2, 2, height + style->height, get_current_rotation());
     }
 
-    image_id = _unk9E32BC;
+    image_id = session->Unk9E32BC;
     if (image_id == 0) {
         image_id = SPRITE_ID_PALETTE_COLOUR_1(COLOUR_SATURATED_BROWN);
     }
@@ -196,12 +200,12 @@ static void park_entrance_paint(paint_session * session, uint8 direction, sint32
 #endif
 
     session->InteractionType = VIEWPORT_INTERACTION_ITEM_PARK;
-    _unk9E32BC = 0;
+    session->Unk9E32BC = 0;
     uint32 image_id, ghost_id = 0;
     if (map_element->flags & MAP_ELEMENT_FLAG_GHOST){
         session->InteractionType = VIEWPORT_INTERACTION_ITEM_NONE;
         ghost_id = construction_markers[gConfigGeneral.construction_marker_colour];
-        _unk9E32BC = ghost_id;
+        session->Unk9E32BC = ghost_id;
     }
 
     rct_footpath_entry* path_entry = get_footpath_entry(map_element->properties.entrance.path_type);
@@ -228,6 +232,9 @@ static void park_entrance_paint(paint_session * session, uint8 direction, sint32
         if (ghost_id != 0)
             break;
 
+        // Format arguments, fonts and the scrolling text cache are shared with other paint threads
+        paint_shared_state_lock();
+
         rct_string_id park_text_id = STR_BANNER_TEXT_CLOSED;
         set_format_arg(0, uint32, 0);
         set_format_arg(4, uint32, 0);
@@ -250,10 +257,15 @@ static void park_entrance_paint(paint_session * session, uint8 direction, sint32
         uint16 string_width = gfx_get_string_width(park_name);
         uint16 scroll = (gCurrentTicks / 2) % string_width;
 
-        if (entrance->scrolling_mode == 0xFF)
+        if (entrance->scrolling_mode == 0xFF) {
+            paint_shared_state_unlock();
             break;
+        }
+
+        uint32 scrollingTextImageId = scrolling_text_setup(session, park_text_id, scroll, entrance->scrolling_mode + direction / 2);
+        paint_shared_state_unlock();
 
-        sub_98199C(session, scrolling_text_setup(session, park_text_id, scroll, entrance->scrolling_mode + direction / 2), 0, 0, 0x1C, 0x1C, 0x2F, height + entrance->text_height, 2, 2, height + entrance->text_height, get_current_rotation());
+        sub_98199C(session, scrollingTextImageId, 0, 0, 0x1C, 0x1C, 0x2F, height + entrance->text_height, 2, 2, height + entrance->text_height, get_current_rotation());
         break;
     case 1:
     case 2:
@@ -342,6 +342,9 @@ void fence_paint(paint_session * session, uint8 direction, sint32 height, rct_ma
         return;
     }
 
+    // Format arguments, fonts and the scrolling text cache are shared with other paint threads
+    paint_shared_state_lock();
+
     set_format_arg(0, uint32, 0);
     set_format_arg(4, uint32, 0);
 
@@ -382,5 +385,8 @@ void fence_paint(paint_session * session, uint8 direction, sint32 height, rct_ma
     uint16 string_width = gfx_get_string_width(signString);
     uint16 scroll = (gCurrentTicks / 2) % string_width;
 
-    sub_98199C(session, scrolling_text_setup(session, stringId, scroll, scrollingMode), 0, 0, 1, 1, 13, height + 8, boundsOffset.x, boundsOffset.y, boundsOffset.z, get_current_rotation());
+    uint32 scrollingTextImageId = scrolling_text_setup(session, stringId, scroll, scrollingMode);
+    paint_shared_state_unlock();
+
+    sub_98199C(session, scrollingTextImageId, 0, 0, 1, 1, 13, height + 8, boundsOffset.x, boundsOffset.y, boundsOffset.z, get_current_rotation());
 }
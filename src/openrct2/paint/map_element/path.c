@@ -394,6 +394,9 @@ static void sub_6A4101(paint_session * session, rct_map_element * map_element, u
             uint16 scrollingMode = footpathEntry->scrolling_mode;
             scrollingMode += direction;
 
+            // Format arguments, fonts and the scrolling text cache are shared with other paint threads
+            paint_shared_state_lock();
+
             set_format_arg(0, uint32, 0);
             set_format_arg(4, uint32, 0);
 
@@ -415,7 +418,10 @@ static void sub_6A4101(paint_session * session, rct_map_element * map_element, u
             uint16 string_width = gfx_get_string_width(gCommonStringFormatBuffer);
             uint16 scroll = (gCurrentTicks / 2) % string_width;
 
-            sub_98199C(session, scrolling_text_setup(session, string_id, scroll, scrollingMode), 0, 0, 1, 1, 21, height + 7,  boundBoxOffsets.x,  boundBoxOffsets.y,  boundBoxOffsets.z, get_current_rotation());
+            uint32 scrollingTextImageId = scrolling_text_setup(session, string_id, scroll, scrollingMode);
+            paint_shared_state_unlock();
+
+            sub_98199C(session, scrollingTextImageId, 0, 0, 1, 1, 21, height + 7,  boundBoxOffsets.x,  boundBoxOffsets.y,  boundBoxOffsets.z, get_current_rotation());
         }
 
         session->InteractionType = VIEWPORT_INTERACTION_ITEM_FOOTPATH;
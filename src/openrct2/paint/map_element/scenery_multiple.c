@@ -87,11 +87,10 @@ static sint32 scenery_multiple_sign_text_height(const utf8 *str, rct_large_scene
     return height;
 }
 
-static const utf8 *scenery_multiple_sign_fit_text(const utf8 *str, rct_large_scenery_text *text, bool height)
+static const utf8 *scenery_multiple_sign_fit_text(utf8 *fitStr, size_t fitStrSize, const utf8 *str, rct_large_scenery_text *text, bool height)
 {
-    static utf8 fitStr[32];
     utf8 *fitStrEnd = fitStr;
-    safe_strcpy(fitStr, str, sizeof(fitStr));
+    safe_strcpy(fitStr, str, fitStrSize);
     sint32 w = 0;
     uint32 codepoint;
     while (w <= text->max_width && (codepoint = utf8_get_next(fitStrEnd, (const utf8**)&fitStrEnd)) != 0) {
@@ -111,7 +110,8 @@ static sint32 div_to_minus_infinity(sint32 a, sint32 b) {
 
 static void scenery_multiple_sign_paint_line(paint_session * session, const utf8 *str, rct_large_scenery_text *text, sint32 textImage, sint32 textColour, uint8 direction, sint32 y_offset)
 {
-    const utf8 *fitStr = scenery_multiple_sign_fit_text(str, text, false);
+    utf8 fitStrBuffer[32];
+    const utf8 *fitStr = scenery_multiple_sign_fit_text(fitStrBuffer, sizeof(fitStrBuffer), str, text, false);
     sint32 width = scenery_multiple_sign_text_width(fitStr, text);
     sint32 x_offset = text->offset[(direction & 1)].x;
     sint32 acc = y_offset * ((direction & 1) ? -1 : 1);
@@ -250,6 +250,8 @@ void scenery_multiple_paint(paint_session * session, uint8 direction, uint16 hei
         }
         // 6B8331:
         // Draw sign text:
+        // Format arguments are shared with other paint threads
+        paint_shared_state_lock();
         set_format_arg(0, uint32, 0);
         set_format_arg(4, uint32, 0);
         sint32 textColour = mapElement->properties.scenerymultiple.colour[1] & 0x1F;
@@ -267,6 +269,7 @@ void scenery_multiple_paint(paint_session * session, uint8 direction, uint16 hei
         }
         utf8 signString[256];
         format_string(signString, sizeof(signString), stringId, gCommonFormatArgs);
+        paint_shared_state_unlock();
         rct_large_scenery_text *text = entry->large_scenery.text;
         sint32 y_offset = (text->offset[(direction & 1)].y * 2);
         if (text->flags & LARGE_SCENERY_TEXT_FLAG_VERTICAL) {
@@ -274,7 +277,7 @@ void scenery_multiple_paint(paint_session * session, uint8 direction, uint16 hei
             y_offset += 1;
             utf8 fitStr[32];
             const utf8 *fitStrPtr = fitStr;
-            safe_strcpy(fitStr, scenery_multiple_sign_fit_text(signString, text, true), sizeof(fitStr));
+            scenery_multiple_sign_fit_text(fitStr, sizeof(fitStr), signString, text, true);
             sint32 height2 = scenery_multiple_sign_text_height(fitStr, text);
             uint32 codepoint;
             while ((codepoint = utf8_get_next(fitStrPtr, &fitStrPtr)) != 0) {
@@ -335,6 +338,8 @@ void scenery_multiple_paint(paint_session * session, uint8 direction, uint16 hei
         return;
     }
     // Draw scrolling text:
+    // Format arguments, fonts and the scrolling text cache are shared with other paint threads
+    paint_shared_state_lock();
     set_format_arg(0, uint32, 0);
     set_format_arg(4, uint32, 0);
     uint8 textColour = mapElement->properties.banner.unused & 0x1F;
@@ -367,7 +372,9 @@ void scenery_multiple_paint(paint_session * session, uint8 direction, uint16 hei
 
     uint16 string_width = gfx_get_string_width(signString);
     uint16 scroll = (gCurrentTicks / 2) % string_width;
-    sub_98199C(session, scrolling_text_setup(session, stringId, scroll, scrollMode), 0, 0, 1, 1, 21, height + 25, boxoffset.x, boxoffset.y, boxoffset.z, get_current_rotation());
+    uint32 scrollingTextImageId = scrolling_text_setup(session, stringId, scroll, scrollMode);
+    paint_shared_state_unlock();
+    sub_98199C(session, scrollingTextImageId, 0, 0, 1, 1, 21, height + 25, boxoffset.x, boxoffset.y, boxoffset.z, get_current_rotation());
 
     scenery_multiple_paint_supports(session, direction, height, mapElement, dword_F4387C, tile);
 }
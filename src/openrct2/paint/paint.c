@@ -32,7 +32,8 @@ const uint32 construction_markers[] = {
 };
 
 paint_session gPaintSession;
-static bool _paintSessionInUse;
+static paint_session * _paintSessionPool[MAX_PAINT_SESSIONS] = { &gPaintSession };
+static bool _paintSessionInUse[MAX_PAINT_SESSIONS];
 
 #ifndef NO_RCT2
 #define _paintQuadrants (RCT2_ADDRESS(0x00F1A50C, paint_struct*))
@@ -67,10 +68,21 @@ static uint32 paint_ps_colourify_image(uint32 imageId, uint8 spriteType, uint32
 
 paint_session * paint_session_alloc(rct_drawpixelinfo * dpi)
 {
-    // Currently limited to just one session at a time
-    assert(!_paintSessionInUse);
-    _paintSessionInUse = true;
-    paint_session * session = &gPaintSession;
+    // Sessions can be allocated by several paint job threads at once
+    paint_session * session = NULL;
+    paint_shared_state_lock();
+    for (sint32 i = 0; i < MAX_PAINT_SESSIONS; i++) {
+        if (!_paintSessionInUse[i]) {
+            if (_paintSessionPool[i] == NULL) {
+                _paintSessionPool[i] = calloc(1, sizeof(paint_session));
+            }
+            _paintSessionInUse[i] = true;
+            session = _paintSessionPool[i];
+            break;
+        }
+    }
+    paint_shared_state_unlock();
+    assert(session != NULL);
 
     paint_session_init(session, dpi);
     return session;
@@ -78,14 +90,73 @@ paint_session * paint_session_alloc(rct_drawpixelinfo * dpi)
 
 void paint_session_free(paint_session * session)
 {
-    _paintSessionInUse = false;
+    paint_shared_state_lock();
+    for (sint32 i = 0; i < MAX_PAINT_SESSIONS; i++) {
+        if (_paintSessionPool[i] == session) {
+            _paintSessionInUse[i] = false;
+            break;
+        }
+    }
+    paint_shared_state_unlock();
+}
+
+static paint_entry_chunk * paint_entry_chunk_alloc()
+{
+    paint_entry_chunk * chunk = malloc(sizeof(paint_entry_chunk));
+    if (chunk != NULL) {
+        chunk->Next = NULL;
+    }
+    return chunk;
+}
+
+static void paint_session_use_chunk(paint_session * session, paint_entry_chunk * chunk)
+{
+    session->CurrentPaintStructChunk = chunk;
+    if (chunk == NULL) {
+        session->NextFreePaintStruct = NULL;
+        session->EndOfPaintStructArray = NULL;
+    } else {
+        session->NextFreePaintStruct = chunk->Entries;
+        session->EndOfPaintStructArray = chunk->Entries + PAINT_STRUCT_CHUNK_SIZE;
+    }
+}
+
+/**
+ * Makes sure NextFreePaintStruct can be used, moving on to the next chunk when the current one is full.
+ * Returns false when no more paint structs can be allocated.
+ */
+static bool paint_session_reserve_entry(paint_session * session)
+{
+    if (session->NextFreePaintStruct < session->EndOfPaintStructArray) {
+        return true;
+    }
+
+    paint_entry_chunk * chunk = session->CurrentPaintStructChunk;
+    if (chunk == NULL) {
+        return false;
+    }
+    if (chunk->Next == NULL) {
+        if (session->NumPaintStructChunks >= MAX_PAINT_STRUCT_CHUNKS) {
+            return false;
+        }
+        chunk->Next = paint_entry_chunk_alloc();
+        if (chunk->Next == NULL) {
+            return false;
+        }
+        session->NumPaintStructChunks++;
+    }
+    paint_session_use_chunk(session, chunk->Next);
+    return true;
 }
 
 static void paint_session_init(paint_session * session, rct_drawpixelinfo * dpi)
 {
     session->Unk140E9A8 = dpi;
-    session->EndOfPaintStructArray = &session->PaintStructs[4000 - 1];
-    session->NextFreePaintStruct = session->PaintStructs;
+    if (session->PaintStructChunks == NULL) {
+        session->PaintStructChunks = paint_entry_chunk_alloc();
+        session->NumPaintStructChunks = session->PaintStructChunks == NULL ? 0 : 1;
+    }
+    paint_session_use_chunk(session, session->PaintStructChunks);
     session->UnkF1AD28 = NULL;
     session->UnkF1AD2C = NULL;
     for (sint32 i = 0; i < MAX_PAINT_QUADRANTS; i++) {
@@ -98,6 +169,7 @@ static void paint_session_init(paint_session * session, rct_drawpixelinfo * dpi)
     session->WoodenSupportsPrependTo = NULL;
     session->CurrentlyDrawnItem = NULL;
     session->SurfaceElement = NULL;
+    session->Unk9E32BC = 0;
 }
 
 static void paint_session_add_ps_to_quadrant(paint_session * session, paint_struct * ps, sint32 positionHash)
@@ -116,7 +188,7 @@ static void paint_session_add_ps_to_quadrant(paint_session * session, paint_stru
  */
 static paint_struct * sub_9819_c(paint_session * session, uint32 image_id, rct_xyz16 offset, rct_xyz16 boundBoxSize, rct_xyz16 boundBoxOffset, uint8 rotation)
 {
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray) return NULL;
+    if (!paint_session_reserve_entry(session)) return NULL;
     paint_struct * ps = &session->NextFreePaintStruct->basic;
 
     ps->image_id = image_id;
@@ -229,7 +301,7 @@ paint_struct * sub_98196C(
     session->UnkF1AD28 = 0;
     session->UnkF1AD2C = NULL;
 
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray) {
+    if (!paint_session_reserve_entry(session)) {
         return NULL;
     }
 
@@ -524,7 +596,7 @@ bool paint_attach_to_previous_attach(paint_session * session, uint32 image_id, u
         return paint_attach_to_previous_ps(session, image_id, x, y);
     }
 
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray) {
+    if (!paint_session_reserve_entry(session)) {
         return false;
     }
     attached_paint_struct * ps = &session->NextFreePaintStruct->attached;
@@ -555,7 +627,7 @@ bool paint_attach_to_previous_attach(paint_session * session, uint32 image_id, u
  */
 bool paint_attach_to_previous_ps(paint_session * session, uint32 image_id, uint16 x, uint16 y)
 {
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray) {
+    if (!paint_session_reserve_entry(session)) {
         return false;
     }
     attached_paint_struct * ps = &session->NextFreePaintStruct->attached;
@@ -594,7 +666,7 @@ bool paint_attach_to_previous_ps(paint_session * session, uint32 image_id, uint1
  */
 void paint_floating_money_effect(paint_session * session, money32 amount, rct_string_id string_id, sint16 y, sint16 z, sint8 y_offsets[], sint16 offset_x, uint32 rotation)
 {
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray) {
+    if (!paint_session_reserve_entry(session)) {
         return;
     }
     paint_string_struct * ps = &session->NextFreePaintStruct->string;
@@ -764,7 +836,11 @@ static bool is_bbox_intersecting(uint8 rotation, const paint_struct_bound_box *i
     return result;
 }
 
-paint_struct * paint_arrange_structs_helper(paint_struct * ps_next, uint16 quadrantIndex, uint8 flag)
+/**
+ * Sorts the paint structs of a quadrant against those of the next one, moving those that have to be drawn first in
+ * front by relinking them. Returns the paint struct to start from for the next quadrant.
+ */
+static paint_struct * paint_arrange_structs_helper(paint_struct * ps_next, uint16 quadrantIndex, uint8 flag, uint8 rotation)
 {
     paint_struct * ps;
     paint_struct * ps_temp;
@@ -794,7 +870,6 @@ paint_struct * paint_arrange_structs_helper(paint_struct * ps_next, uint16 quadr
     } while (ps->quadrant_index <= quadrantIndex + 1);
     ps = ps_temp;
 
-    uint8 rotation = get_current_rotation();
     while (true) {
         while (true) {
             ps_next = ps->next_quadrant_ps;
@@ -870,11 +945,12 @@ paint_struct paint_session_arrange(paint_session * session)
             }
         } while (++quadrantIndex <= session->QuadrantFrontIndex);
 
-        paint_struct * ps_cache = paint_arrange_structs_helper(&psHead, session->QuadrantBackIndex & 0xFFFF, PAINT_QUADRANT_FLAG_NEXT);
+        uint8 rotation = get_current_rotation();
+        paint_struct * ps_cache = paint_arrange_structs_helper(&psHead, session->QuadrantBackIndex & 0xFFFF, PAINT_QUADRANT_FLAG_NEXT, rotation);
 
         quadrantIndex = session->QuadrantBackIndex;
         while (++quadrantIndex < session->QuadrantFrontIndex) {
-            ps_cache = paint_arrange_structs_helper(ps_cache, quadrantIndex & 0xFFFF, 0);
+            ps_cache = paint_arrange_structs_helper(ps_cache, quadrantIndex & 0xFFFF, 0, rotation);
         }
     }
     return psHead;
@@ -143,11 +143,27 @@ typedef struct tunnel_entry {
 
 #define MAX_PAINT_QUADRANTS 512
 #define TUNNEL_MAX_COUNT    65
+#define MAX_PAINT_SESSIONS  16
+#define PAINT_STRUCT_CHUNK_SIZE 4000
+#define MAX_PAINT_STRUCT_CHUNKS 64
+
+typedef struct paint_entry_chunk paint_entry_chunk;
+
+/**
+ * Paint structs are allocated from chunks that are kept for the next time the session is used, more chunks are
+ * added when a dense scene needs them.
+ */
+struct paint_entry_chunk {
+    paint_entry         Entries[PAINT_STRUCT_CHUNK_SIZE];
+    paint_entry_chunk * Next;
+};
 
 typedef struct paint_session
 {
     rct_drawpixelinfo *     Unk140E9A8;
-    paint_entry             PaintStructs[4000];
+    paint_entry_chunk *     PaintStructChunks;
+    paint_entry_chunk *     CurrentPaintStructChunk;
+    uint32                  NumPaintStructChunks;
     paint_struct *          Quadrants[MAX_PAINT_QUADRANTS];
     uint32                  QuadrantBackIndex;
     uint32                  QuadrantFrontIndex;
@@ -175,6 +191,7 @@ typedef struct paint_session
     uint8                   Unk141E9DB;
     uint16                  Unk141E9DC;
     uint32                  TrackColours[4];
+    uint32                  Unk9E32BC;
 } paint_session;
 
 extern paint_session gPaintSession;
@@ -232,10 +249,17 @@ paint_session * paint_session_alloc(rct_drawpixelinfo * dpi);
 void paint_session_free(paint_session *);
 void paint_session_generate(paint_session * session);
 paint_struct paint_session_arrange(paint_session * session);
-paint_struct * paint_arrange_structs_helper(paint_struct * ps_next, uint16 quadrantIndex, uint8 flag);
 void paint_draw_structs(rct_drawpixelinfo * dpi, paint_struct * ps, uint32 viewFlags);
 void paint_draw_money_structs(rct_drawpixelinfo * dpi, paint_string_struct * ps);
 
+// Multithreaded painting
+typedef void (*paint_job_callback)(sint32 index, void * arg);
+
+bool paint_jobs_enabled();
+void paint_jobs_run(paint_job_callback callback, sint32 count, void * arg);
+void paint_shared_state_lock();
+void paint_shared_state_unlock();
+
 // TESTING
 #ifdef __TESTPAINT__
     void testpaint_clear_ignore();
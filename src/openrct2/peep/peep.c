@@ -649,9 +649,11 @@ static uint8 peep_assess_surroundings(sint16 centre_x, sint16 centre_y, sint16 c
         }
     }
 
-    rct_litter* litter;
-    for (uint16 sprite_idx = gSpriteListHead[SPRITE_LIST_LITTER]; sprite_idx != SPRITE_INDEX_NULL; sprite_idx = litter->next) {
-        litter = &(get_sprite(sprite_idx)->litter);
+    sprite_spatial_query query;
+    rct_sprite* sprite;
+    sprite_spatial_query_begin_around(&query, centre_x, centre_y, 160, SPRITE_LIST_LITTER);
+    while ((sprite = sprite_spatial_query_next(&query)) != NULL) {
+        rct_litter* litter = &sprite->litter;
 
         sint16 dist_x = abs(litter->x - centre_x);
         sint16 dist_y = abs(litter->y - centre_y);
@@ -5405,14 +5407,12 @@ static sint32 peep_update_walking_find_bench(rct_peep* peep){
 
     for (; !(edges & (1 << chosen_edge));)chosen_edge = (chosen_edge + 1) & 0x3;
 
-    uint16 sprite_id = sprite_get_first_in_quadrant(peep->x, peep->y);
+    sprite_spatial_query query;
+    rct_sprite* sprite;
     uint8 free_edge = 3;
 
-    for (rct_sprite* sprite; sprite_id != SPRITE_INDEX_NULL; sprite_id = sprite->unknown.next_in_quadrant){
-        sprite = get_sprite(sprite_id);
-
-        if (sprite->unknown.linked_list_type_offset != SPRITE_LIST_PEEP * 2) continue;
-
+    sprite_spatial_query_begin_tile(&query, peep->x, peep->y, SPRITE_LIST_PEEP);
+    while ((sprite = sprite_spatial_query_next(&query)) != NULL){
         if (sprite->peep.state != PEEP_STATE_SITTING)continue;
 
         if (peep->z != sprite->peep.z)continue;
@@ -6288,16 +6288,11 @@ static sint32 peep_update_patrolling_find_sweeping(rct_peep* peep){
     if (!(peep->staff_orders & STAFF_ORDERS_SWEEPING))
         return 0;
 
-    uint16 sprite_id = sprite_get_first_in_quadrant(peep->x, peep->y);
-
-    for (rct_sprite* sprite = NULL;
-        sprite_id != SPRITE_INDEX_NULL;
-        sprite_id = sprite->unknown.next_in_quadrant){
-
-        sprite = get_sprite(sprite_id);
-
-        if (sprite->unknown.linked_list_type_offset != SPRITE_LIST_LITTER * 2) continue;
+    sprite_spatial_query query;
+    rct_sprite* sprite;
 
+    sprite_spatial_query_begin_tile(&query, peep->x, peep->y, SPRITE_LIST_LITTER);
+    while ((sprite = sprite_spatial_query_next(&query)) != NULL){
         uint16 z_diff = abs(peep->z - sprite->litter.z);
 
         if (z_diff >= 16)continue;
@@ -6576,12 +6571,11 @@ static void peep_update_walking(rct_peep* peep){
     if (!peep_find_ride_to_look_at(peep, chosen_edge, &ride_to_view, &ride_seat_to_view))
         return;
 
-    uint16 sprite_id = sprite_get_first_in_quadrant(peep->x, peep->y);
-    for (rct_sprite* sprite; sprite_id != SPRITE_INDEX_NULL; sprite_id = sprite->unknown.next_in_quadrant){
-        sprite = get_sprite(sprite_id);
-
-        if (sprite->unknown.linked_list_type_offset != SPRITE_LIST_PEEP * 2) continue;
+    sprite_spatial_query query;
+    rct_sprite* sprite;
 
+    sprite_spatial_query_begin_tile(&query, peep->x, peep->y, SPRITE_LIST_PEEP);
+    while ((sprite = sprite_spatial_query_next(&query)) != NULL){
         if (sprite->peep.state != PEEP_STATE_WATCHING)continue;
 
         if (peep->z != sprite->peep.z)continue;
@@ -8265,31 +8259,32 @@ static sint32 peep_footpath_move_forward(rct_peep* peep, sint16 x, sint16 y, rct
     uint16 crowded = 0;
     uint8 litter_count = 0;
     uint8 sick_count = 0;
-    uint16 sprite_id = sprite_get_first_in_quadrant(x, y);
-    for (rct_sprite* sprite; sprite_id != SPRITE_INDEX_NULL; sprite_id = sprite->unknown.next_in_quadrant){
-        sprite = get_sprite(sprite_id);
-        if (sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_PEEP){
-            rct_peep* other_peep = (rct_peep*)sprite;
-            if (other_peep->state != PEEP_STATE_WALKING)
-                continue;
+    sprite_spatial_query query;
+    rct_sprite* sprite;
 
-            if (abs(other_peep->z - peep->next_z * 8) > 16)
-                continue;
-            crowded++;
+    sprite_spatial_query_begin_tile(&query, x, y, SPRITE_LIST_PEEP);
+    while ((sprite = sprite_spatial_query_next(&query)) != NULL){
+        rct_peep* other_peep = (rct_peep*)sprite;
+        if (other_peep->state != PEEP_STATE_WALKING)
             continue;
-        }
-        else if (sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_LITTER){
-            rct_litter* litter = (rct_litter*)sprite;
-            if (abs(litter->z - peep->next_z * 8) > 16)
-                continue;
 
-            litter_count++;
-            if (litter->type != LITTER_TYPE_SICK && litter->type != LITTER_TYPE_SICK_ALT)
-                continue;
+        if (abs(other_peep->z - peep->next_z * 8) > 16)
+            continue;
+        crowded++;
+    }
 
-            litter_count--;
-            sick_count++;
-        }
+    sprite_spatial_query_begin_tile(&query, x, y, SPRITE_LIST_LITTER);
+    while ((sprite = sprite_spatial_query_next(&query)) != NULL){
+        rct_litter* litter = (rct_litter*)sprite;
+        if (abs(litter->z - peep->next_z * 8) > 16)
+            continue;
+
+        litter_count++;
+        if (litter->type != LITTER_TYPE_SICK && litter->type != LITTER_TYPE_SICK_ALT)
+            continue;
+
+        litter_count--;
+        sick_count++;
     }
 
     if (crowded >= 10 &&
@@ -9517,6 +9512,159 @@ static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep
     return;
 }
 
+/* Results of the heuristic search for guests, shared between guests searching from
+ * the same place for the same goal. A search only depends on its parameters, the
+ * junctions the guest remembers and the map, so any change to the map invalidates
+ * every entry by advancing the generation. An element store swapped in for a while,
+ * like the one track design previews are placed in, has its own cache swapped in
+ * with it. */
+#define PEEP_PATHFIND_CACHE_SIZE 8192
+
+typedef struct peep_pathfind_cache_key {
+    sint16 x;
+    sint16 y;
+    rct_xyz16 goal;
+    uint8 z;
+    uint8 height;
+    uint8 test_edge;
+    uint8 queue_ride_index;
+    uint8 ignore_foreign_queues;
+    sint32 max_junctions;
+    sint32 max_tiles_checked;
+    rct_xyzd8 history[4];
+} peep_pathfind_cache_key;
+
+typedef struct peep_pathfind_cache_entry {
+    peep_pathfind_cache_key key;
+    uint32 generation;
+    uint16 score;
+    uint8 steps;
+} peep_pathfind_cache_entry;
+
+struct peep_pathfind_cache {
+    peep_pathfind_cache_entry *entries;
+    uint32 generation;
+};
+
+static peep_pathfind_cache_entry *_peepPathFindCache = NULL;
+static uint32 _peepPathFindCacheGeneration = 1;
+
+/**
+ * Creates an empty cache, to be swapped in along with the element store it is for.
+ */
+peep_pathfind_cache *peep_pathfind_cache_create()
+{
+    peep_pathfind_cache *cache = calloc(1, sizeof(peep_pathfind_cache));
+    if (cache != NULL) {
+        cache->generation = 1;
+    }
+    return cache;
+}
+
+/**
+ * Exchanges the cache in use with the given one, nothing is copied.
+ */
+void peep_pathfind_cache_swap(peep_pathfind_cache *cache)
+{
+    peep_pathfind_cache current;
+    current.entries = _peepPathFindCache;
+    current.generation = _peepPathFindCacheGeneration;
+
+    _peepPathFindCache = cache->entries;
+    _peepPathFindCacheGeneration = cache->generation;
+
+    *cache = current;
+}
+
+/**
+ * Frees a cache created by peep_pathfind_cache_create, which must not be swapped in.
+ */
+void peep_pathfind_cache_free(peep_pathfind_cache *cache)
+{
+    if (cache == NULL) {
+        return;
+    }
+    free(cache->entries);
+    free(cache);
+}
+
+/**
+ * Invalidates all cached pathfinding results, must be called whenever the map changes.
+ */
+void peep_pathfind_cache_invalidate()
+{
+    _peepPathFindCacheGeneration++;
+    if (_peepPathFindCacheGeneration == 0) {
+        // Entries from before wrapping around could otherwise be mistaken as valid
+        if (_peepPathFindCache != NULL) {
+            memset(_peepPathFindCache, 0, PEEP_PATHFIND_CACHE_SIZE * sizeof(peep_pathfind_cache_entry));
+        }
+        _peepPathFindCacheGeneration = 1;
+    }
+}
+
+static void peep_pathfind_cache_make_key(peep_pathfind_cache_key *key, sint16 x, sint16 y, uint8 z, uint8 height, sint32 test_edge, rct_peep *peep)
+{
+    // Cleared first so that padding does not affect comparing keys
+    memset(key, 0, sizeof(peep_pathfind_cache_key));
+    key->x = x;
+    key->y = y;
+    key->goal = gPeepPathFindGoalPosition;
+    key->z = z;
+    key->height = height;
+    key->test_edge = (uint8)test_edge;
+    key->queue_ride_index = gPeepPathFindQueueRideIndex;
+    key->ignore_foreign_queues = gPeepPathFindIgnoreForeignQueues ? 1 : 0;
+    key->max_junctions = _peepPathFindMaxJunctions;
+    key->max_tiles_checked = _peepPathFindTilesChecked;
+
+    // The search only looks junctions up in the history, so sort it to share results regardless of order
+    memcpy(key->history, peep->pathfind_history, sizeof(key->history));
+    for (sint32 i = 1; i < 4; i++) {
+        rct_xyzd8 junction = key->history[i];
+        sint32 j = i;
+        for (; j > 0 && memcmp(&key->history[j - 1], &junction, sizeof(rct_xyzd8)) > 0; j--) {
+            key->history[j] = key->history[j - 1];
+        }
+        key->history[j] = junction;
+    }
+}
+
+static peep_pathfind_cache_entry *peep_pathfind_cache_get_entry(const peep_pathfind_cache_key *key)
+{
+    if (_peepPathFindCache == NULL) {
+        _peepPathFindCache = calloc(PEEP_PATHFIND_CACHE_SIZE, sizeof(peep_pathfind_cache_entry));
+    }
+
+    // FNV-1a
+    uint32 hash = 2166136261u;
+    const uint8 *keyBytes = (const uint8 *)key;
+    for (size_t i = 0; i < sizeof(peep_pathfind_cache_key); i++) {
+        hash = (hash ^ keyBytes[i]) * 16777619u;
+    }
+    return &_peepPathFindCache[hash & (PEEP_PATHFIND_CACHE_SIZE - 1)];
+}
+
+static bool peep_pathfind_cache_get(const peep_pathfind_cache_key *key, uint16 *score, uint8 *steps)
+{
+    const peep_pathfind_cache_entry *entry = peep_pathfind_cache_get_entry(key);
+    if (entry->generation != _peepPathFindCacheGeneration || memcmp(&entry->key, key, sizeof(peep_pathfind_cache_key)) != 0) {
+        return false;
+    }
+    *score = entry->score;
+    *steps = entry->steps;
+    return true;
+}
+
+static void peep_pathfind_cache_set(const peep_pathfind_cache_key *key, uint16 score, uint8 steps)
+{
+    peep_pathfind_cache_entry *entry = peep_pathfind_cache_get_entry(key);
+    entry->key = *key;
+    entry->generation = _peepPathFindCacheGeneration;
+    entry->score = score;
+    entry->steps = steps;
+}
+
 /**
  * Returns:
  *   -1   - no direction chosen
@@ -9766,7 +9914,18 @@ sint32 peep_pathfind_choose_direction(sint16 x, sint16 y, uint8 z, rct_peep *pee
             }
             #endif // defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
 
-            peep_pathfind_heuristic_search(x, y, height, peep, first_map_element, inPatrolArea, 0, &score, test_edge, &endJunctions, endJunctionList, endDirectionList, &endXYZ, &endSteps);
+            // Staff searches also depend on their patrol area and type, so only guests share results
+            peep_pathfind_cache_key cacheKey;
+            bool cacheable = peep->type == PEEP_TYPE_GUEST;
+            if (cacheable) {
+                peep_pathfind_cache_make_key(&cacheKey, x, y, z, height, test_edge, peep);
+            }
+            if (!cacheable || !peep_pathfind_cache_get(&cacheKey, &score, &endSteps)) {
+                peep_pathfind_heuristic_search(x, y, height, peep, first_map_element, inPatrolArea, 0, &score, test_edge, &endJunctions, endJunctionList, endDirectionList, &endXYZ, &endSteps);
+                if (cacheable) {
+                    peep_pathfind_cache_set(&cacheKey, score, endSteps);
+                }
+            }
 
             #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
             if (gPathFindDebug) {
@@ -11223,16 +11382,12 @@ static void peep_apply_easter_egg_to_nearby_guests(rct_peep *peep, easter_egg_fu
     if (!peep_has_valid_xy(peep))
         return;
 
-    uint16 spriteIndex = sprite_get_first_in_quadrant(peep->x, peep->y);
-    if (spriteIndex == SPRITE_INDEX_NULL)
-        return;
+    sprite_spatial_query query;
+    rct_sprite * sprite;
 
-    rct_peep * otherPeep = GET_PEEP(spriteIndex);
-    for (; spriteIndex != SPRITE_INDEX_NULL; spriteIndex = otherPeep->next_in_quadrant) {
-        otherPeep = GET_PEEP(spriteIndex);
-
-        if (otherPeep->sprite_identifier != SPRITE_IDENTIFIER_PEEP)
-            continue;
+    sprite_spatial_query_begin_tile(&query, peep->x, peep->y, SPRITE_LIST_PEEP);
+    while ((sprite = sprite_spatial_query_next(&query)) != NULL) {
+        rct_peep * otherPeep = &sprite->peep;
 
         if (otherPeep->type != PEEP_TYPE_GUEST)
             continue;
@@ -12212,23 +12367,13 @@ static void peep_head_for_nearest_ride_type(rct_peep *peep, sint32 rideType)
             }
         }
     } else {
-        // Take nearby rides into consideration
-        sint32 cx = floor2(peep->x, 32);
-        sint32 cy = floor2(peep->y, 32);
-        for (sint32 x = cx - 320; x <= cx + 320; x += 32) {
-            for (sint32 y = cy - 320; y <= cy + 320; y += 32) {
-                if (x >= 0 && y >= 0 && x < (256 * 32) && y < (256 * 32)) {
-                    rct_map_element *mapElement = map_get_first_element_at(x >> 5, y >> 5);
-                    do {
-                        if (map_element_get_type(mapElement) != MAP_ELEMENT_TYPE_TRACK) continue;
-
-                        sint32 rideIndex = mapElement->properties.track.ride_index;
-                        ride = get_ride(rideIndex);
-                        if (ride->type == rideType) {
-                            _peepRideConsideration[rideIndex >> 5] |= (1u << (rideIndex & 0x1F));
-                        }
-                    } while (!map_element_is_last_for_tile(mapElement++));
-                }
+        // Take nearby rides into consideration, i.e. rides with track within 10 tiles
+        uint32 nearbyRides[8];
+        ride_get_rides_with_track_near(peep->x >> 5, peep->y >> 5, 10, nearbyRides);
+        sint32 i;
+        FOR_ALL_RIDES(i, ride) {
+            if ((nearbyRides[i >> 5] & (1u << (i & 0x1F))) && ride->type == rideType) {
+                _peepRideConsideration[i >> 5] |= (1u << (i & 0x1F));
             }
         }
     }
@@ -12319,23 +12464,13 @@ static void peep_head_for_nearest_ride_with_flags(rct_peep *peep, sint32 rideTyp
             }
         }
     } else {
-        // Take nearby rides into consideration
-        sint32 cx = floor2(peep->x, 32);
-        sint32 cy = floor2(peep->y, 32);
-        for (sint32 x = cx - 320; x <= cx + 320; x += 32) {
-            for (sint32 y = cy - 320; y <= cy + 320; y += 32) {
-                if (x >= 0 && y >= 0 && x < (256 * 32) && y < (256 * 32)) {
-                    rct_map_element *mapElement = map_get_first_element_at(x >> 5, y >> 5);
-                    do {
-                        if (map_element_get_type(mapElement) != MAP_ELEMENT_TYPE_TRACK) continue;
-
-                        sint32 rideIndex = mapElement->properties.track.ride_index;
-                        ride = get_ride(rideIndex);
-                        if (ride_type_has_flag(ride->type, rideTypeFlags)) {
-                            _peepRideConsideration[rideIndex >> 5] |= (1u << (rideIndex & 0x1F));
-                        }
-                    } while (!map_element_is_last_for_tile(mapElement++));
-                }
+        // Take nearby rides into consideration, i.e. rides with track within 10 tiles
+        uint32 nearbyRides[8];
+        ride_get_rides_with_track_near(peep->x >> 5, peep->y >> 5, 10, nearbyRides);
+        sint32 i;
+        FOR_ALL_RIDES(i, ride) {
+            if ((nearbyRides[i >> 5] & (1u << (i & 0x1F))) && ride_type_has_flag(ride->type, rideTypeFlags)) {
+                _peepRideConsideration[i >> 5] |= (1u << (i & 0x1F));
             }
         }
     }
@@ -774,6 +774,11 @@ void game_command_set_guest_name(sint32 *eax, sint32 *ebx, sint32 *ecx, sint32 *
 
 sint32 peep_pathfind_choose_direction(sint16 x, sint16 y, uint8 z, rct_peep *peep);
 void peep_reset_pathfind_goal(rct_peep *peep);
+typedef struct peep_pathfind_cache peep_pathfind_cache;
+peep_pathfind_cache *peep_pathfind_cache_create();
+void peep_pathfind_cache_swap(peep_pathfind_cache *cache);
+void peep_pathfind_cache_free(peep_pathfind_cache *cache);
+void peep_pathfind_cache_invalidate();
 
 bool is_valid_path_z_and_direction(rct_map_element *mapElement, sint32 currentZ, sint32 currentDirection);
 
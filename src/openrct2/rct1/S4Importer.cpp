@@ -2259,6 +2259,7 @@ private:
         }
 
         gNextFreeMapElement = nextFreeMapElement;
+        map_element_allocator_reset();
     }
 
     void FixSceneryColours()
@@ -16,16 +16,43 @@
 
 #include "../core/Exception.hpp"
 #include "../core/IStream.hpp"
+#include "../core/JobPool.hpp"
 #include "../core/Math.hpp"
 #include "SawyerChunkWriter.h"
 
 #include "../util/sawyercoding.h"
 
-// Maximum buffer size to store compressed data, maximum of 16 MiB
-constexpr size_t MAX_COMPRESSED_CHUNK_SIZE = 16 * 1024 * 1024;
+/**
+ * Returns the most bytes a chunk of the given length can take up once encoded, including the chunk header. A run
+ * encoded pair can take as many bytes as it replaces and the single bytes between pairs two, so run length encoding
+ * grows the data by less than half. Repeat encoding at most doubles it.
+ */
+static size_t GetMaxEncodedLength(size_t length, SAWYER_ENCODING encoding)
+{
+    size_t maxLength = length;
+    switch (encoding) {
+    case SAWYER_ENCODING::RLE:
+        maxLength = length + length / 2 + 16;
+        break;
+    case SAWYER_ENCODING::RLECOMPRESSED:
+        maxLength = length * 3 + 16;
+        break;
+    default:
+        break;
+    }
+    return sizeof(sawyercoding_chunk_header) + maxLength;
+}
 
-SawyerChunkWriter::SawyerChunkWriter(IStream * stream)
+SawyerChunkWriter::SawyerChunkWriter(IStream * stream, bool encodeInParallel)
     : _stream(stream)
+{
+    if (encodeInParallel)
+    {
+        _jobPool = std::unique_ptr<JobPool>(new JobPool());
+    }
+}
+
+SawyerChunkWriter::~SawyerChunkWriter()
 {
 }
 
@@ -35,13 +62,44 @@ void SawyerChunkWriter::WriteChunk(const SawyerChunk * chunk)
 }
 
 void SawyerChunkWriter::WriteChunk(const void * src, size_t length, SAWYER_ENCODING encoding)
+{
+    auto encodedChunk = std::unique_ptr<EncodedChunk>(new EncodedChunk());
+    if (_jobPool == nullptr)
+    {
+        Encode(encodedChunk.get(), src, length, encoding);
+        _stream->Write(encodedChunk->Data.get(), encodedChunk->Length);
+        return;
+    }
+
+    EncodedChunk * pendingChunk = encodedChunk.get();
+    _pendingChunks.push_back(std::move(encodedChunk));
+    _jobPool->AddTask([pendingChunk, src, length, encoding]() -> void
+    {
+        Encode(pendingChunk, src, length, encoding);
+    });
+}
+
+void SawyerChunkWriter::Flush()
+{
+    if (_jobPool != nullptr)
+    {
+        _jobPool->Join();
+    }
+    for (const auto &encodedChunk : _pendingChunks)
+    {
+        _stream->Write(encodedChunk->Data.get(), encodedChunk->Length);
+    }
+    _pendingChunks.clear();
+}
+
+void SawyerChunkWriter::Encode(EncodedChunk * encodedChunk, const void * src, size_t length, SAWYER_ENCODING encoding)
 {
     sawyercoding_chunk_header header;
     header.encoding = (uint8)encoding;
     header.length = (uint32)length;
 
-    auto data = std::make_unique<uint8[]>(MAX_COMPRESSED_CHUNK_SIZE);
-    size_t dataLength = sawyercoding_write_chunk_buffer(data.get(), (const uint8 *)src, header);
-
-    _stream->Write(data.get(), dataLength);
+    // Left uninitialised, only the part the encoded chunk is written to is ever touched. Sized for the chunk, as all
+    // chunks of a park are kept until they are written when encoding in parallel.
+    encodedChunk->Data = std::unique_ptr<uint8[]>(new uint8[GetMaxEncodedLength(length, encoding)]);
+    encodedChunk->Length = sawyercoding_write_chunk_buffer(encodedChunk->Data.get(), (const uint8 *)src, header);
 }
@@ -19,22 +19,39 @@
 #ifdef __cplusplus
 
 #include <memory>
+#include <vector>
 #include "../common.h"
 #include "SawyerChunk.h"
 
 interface IStream;
+class JobPool;
 
 /**
  * Writes sawyer encoding chunks to a data stream. This can be used to write
  * SC6 and SV6 files.
+ *
+ * Chunks can be encoded in parallel, they are then written to the stream in
+ * order by Flush, and the data of each chunk must stay valid until then.
  */
 class SawyerChunkWriter final
 {
 private:
+    struct EncodedChunk
+    {
+        std::unique_ptr<uint8[]>    Data;
+        size_t                      Length = 0;
+    };
+
     IStream * const _stream = nullptr;
+    std::vector<std::unique_ptr<EncodedChunk>> _pendingChunks;
+    // Declared last so that it finishes its tasks before the chunks are freed
+    std::unique_ptr<JobPool> _jobPool;
+
+    static void Encode(EncodedChunk * encodedChunk, const void * src, size_t length, SAWYER_ENCODING encoding);
 
 public:
-    SawyerChunkWriter(IStream * stream);
+    explicit SawyerChunkWriter(IStream * stream, bool encodeInParallel = false);
+    ~SawyerChunkWriter();
 
     /**
      * Writes a chunk to the stream.
@@ -56,6 +73,12 @@ public:
     {
         WriteChunk(src, sizeof(T), encoding);
     }
+
+    /**
+     * Waits for the chunks that are being encoded and writes them to the stream,
+     * must be called before anything else is written to the stream.
+     */
+    void Flush();
 };
 
 #endif
@@ -15,8 +15,11 @@
 #pragma endregion
 
 #include "../core/Exception.hpp"
+#include "../core/File.h"
+#include "../core/FileScanner.h"
 #include "../core/FileStream.hpp"
 #include "../core/IStream.hpp"
+#include "../core/Math.hpp"
 #include "../core/String.hpp"
 #include "../core/Util.hpp"
 #include "../management/award.h"
@@ -25,7 +28,10 @@
 #include "../object/ObjectRepository.h"
 #include "../rct12/SawyerChunkWriter.h"
 #include "S6Exporter.h"
+#include <algorithm>
 #include <functional>
+#include <memory>
+#include <thread>
 
 #include "../config/Config.h"
 #include "../game.h"
@@ -86,9 +92,11 @@ void S6Exporter::Save(IStream * stream, bool isScenario)
     _s6.header.num_packed_objects = uint16(ExportObjectsList.size());
     _s6.header.version            = S6_RCT2_VERSION;
     _s6.header.magic_number       = S6_MAGIC_NUMBER;
+    _s6.header.num_extra_map_elements = (uint32)_extraMapElements.size();
     _s6.game_version_number       = 201028;
 
-    auto chunkWriter = SawyerChunkWriter(stream);
+    // The chunks are encoded in parallel, the large ones take most of the time to save
+    SawyerChunkWriter chunkWriter(stream, true);
 
     // 0: Write header chunk
     chunkWriter.WriteChunk(&_s6.header, SAWYER_ENCODING::ROTATE);
@@ -102,6 +110,7 @@ void S6Exporter::Save(IStream * stream, bool isScenario)
     // 2: Write packed objects
     if (_s6.header.num_packed_objects > 0)
     {
+        chunkWriter.Flush();
         IObjectRepository * objRepo = GetObjectRepository();
         objRepo->WritePackedObjects(stream, ExportObjectsList);
     }
@@ -133,6 +142,14 @@ void S6Exporter::Save(IStream * stream, bool isScenario)
         chunkWriter.WriteChunk(&_s6.next_free_map_element_pointer_index, 0x2E8570, SAWYER_ENCODING::RLECOMPRESSED);
     }
 
+    // 7: Map elements that do not fit in RCT2, only written for parks that have outgrown it
+    if (_extraMapElements.size() > 0)
+    {
+        chunkWriter.WriteChunk(_extraMapElements.data(), _extraMapElements.size() * sizeof(rct_map_element), SAWYER_ENCODING::RLECOMPRESSED);
+    }
+
+    chunkWriter.Flush();
+
     // Determine number of bytes written
     size_t fileSize = stream->GetLength();
 
@@ -182,8 +199,6 @@ void S6Exporter::Export()
     _s6.scenario_srand_0 = gScenarioSrand0;
     _s6.scenario_srand_1 = gScenarioSrand1;
 
-    memcpy(_s6.map_elements, gMapElements, sizeof(_s6.map_elements));
-
     _s6.next_free_map_element_pointer_index = gNextFreeMapElementPointerIndex;
     // Sprites needs to be reset before they get used.
     // Might as well reset them in here to zero out the space and improve
@@ -408,7 +423,12 @@ void S6Exporter::Export()
         scenario_remove_trackless_rides(&_s6);
     }
 
-    scenario_fix_ghosts(&_s6);
+    // Map elements are written to map_elements as long as they fit, the rest goes to an extra chunk
+    std::vector<rct_map_element> mapElements(gNextFreeMapElement - gMapElements);
+    size_t numMapElements = scenario_fix_ghosts(&_s6, mapElements.data());
+    size_t numRCT2MapElements = Math::Min(numMapElements, (size_t)MAX_MAP_ELEMENTS);
+    memcpy(_s6.map_elements, mapElements.data(), numRCT2MapElements * sizeof(rct_map_element));
+    _extraMapElements.assign(mapElements.begin() + numRCT2MapElements, mapElements.begin() + numMapElements);
     game_convert_strings_to_rct2(&_s6);
 }
 
@@ -651,6 +671,63 @@ void S6Exporter::ExportRide(rct2_ride * dst, const Ride * src)
     // pad_208[0x58];
 }
 
+/**
+ * The thread writing an autosave in the background, if any. It is waited for before the next autosave is started and
+ * when the context is destroyed. Being a static, it is also waited for by its destructor when the program exits any
+ * other way, such as through exit(), rather than terminating the program because the thread is still running.
+ */
+class AutosaveThread final
+{
+private:
+    std::thread _thread;
+
+public:
+    ~AutosaveThread()
+    {
+        Wait();
+    }
+
+    void Start(std::function<void()> func)
+    {
+        Wait();
+        _thread = std::thread(func);
+    }
+
+    void Wait()
+    {
+        if (_thread.joinable())
+        {
+            _thread.join();
+        }
+    }
+};
+
+static AutosaveThread _autosaveThread;
+
+/**
+ * Deletes the oldest files matching the pattern until there are no more than the given number left.
+ */
+static void scenario_limit_autosave_count(const std::string &pattern, size_t numberOfFilesToKeep)
+{
+    std::vector<std::string> autosaveFiles;
+    auto scanner = std::unique_ptr<IFileScanner>(Path::ScanDirectory(pattern, false));
+    while (scanner->Next())
+    {
+        autosaveFiles.push_back(scanner->GetPath());
+    }
+    if (autosaveFiles.size() <= numberOfFilesToKeep)
+    {
+        return;
+    }
+
+    // The names of the autosaves start with the date and time they were saved at, so the oldest sort first
+    std::sort(autosaveFiles.begin(), autosaveFiles.end());
+    for (size_t i = 0; i < autosaveFiles.size() - numberOfFilesToKeep; i++)
+    {
+        File::Delete(autosaveFiles[i]);
+    }
+}
+
 extern "C"
 {
     enum {
@@ -680,7 +757,7 @@ extern "C"
             window_close_construction_windows();
         }
 
-        map_reorganise_elements();
+        // The export copies the elements tile by tile, so the map elements do not need to be reorganised first
         viewport_set_saved_view();
 
         bool result     = false;
@@ -717,4 +794,66 @@ extern "C"
         }
         return result;
     }
+
+    /**
+     * Saves the park like scenario_save without stopping the game for long. Only the export of the park happens on
+     * the calling thread; removing the oldest autosaves, backing up an existing file at the path and encoding and
+     * writing the park happen on a background thread. Objects are never packed in an autosave.
+     */
+    void scenario_autosave(const utf8 * path, const utf8 * backupPath, const utf8 * pattern, size_t numberOfFilesToKeep, sint32 flags)
+    {
+        scenario_autosave_wait();
+
+        viewport_set_saved_view();
+
+        auto s6exporter = std::make_shared<S6Exporter>();
+        try
+        {
+            s6exporter->RemoveTracklessRides = true;
+            s6exporter->Export();
+        }
+        catch (const Exception &)
+        {
+            log_error("Unable to export the park for the autosave.");
+            return;
+        }
+        gfx_invalidate_screen();
+
+        bool isScenario = (flags & S6_SAVE_FLAG_SCENARIO) != 0;
+        std::string savePath = path;
+        std::string saveBackupPath = backupPath;
+        std::string savePattern = pattern;
+        _autosaveThread.Start([s6exporter, isScenario, savePath, saveBackupPath, savePattern, numberOfFilesToKeep]() -> void
+        {
+            scenario_limit_autosave_count(savePattern, numberOfFilesToKeep);
+            if (File::Exists(savePath))
+            {
+                File::Copy(savePath, saveBackupPath, true);
+            }
+
+            try
+            {
+                if (isScenario)
+                {
+                    s6exporter->SaveScenario(savePath.c_str());
+                }
+                else
+                {
+                    s6exporter->SaveGame(savePath.c_str());
+                }
+            }
+            catch (const Exception &)
+            {
+                log_error("Unable to write the autosave to %s.", savePath.c_str());
+            }
+        });
+    }
+
+    /**
+     * Waits for the autosave that is being written in the background to finish.
+     */
+    void scenario_autosave_wait()
+    {
+        _autosaveThread.Wait();
+    }
 }
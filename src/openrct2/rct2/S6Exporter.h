@@ -50,6 +50,7 @@ public:
 
 private:
     rct_s6_data _s6;
+    std::vector<rct_map_element> _extraMapElements;
 
     void Save(IStream * stream, bool isScenario);
     static uint32 GetLoanHash(money32 initialCash, money32 bankLoan, uint32 maxBankLoan);
@@ -70,6 +70,8 @@ private:
     rct_s6_data     _s6;
     uint8           _gameVersion = 0;
 
+    std::vector<rct_map_element> _extraMapElements;
+
 public:
     S6Importer(IObjectRepository * objectRepository, IObjectManager * objectManager)
         : _objectRepository(objectRepository),
@@ -170,6 +172,18 @@ public:
             chunkReader.ReadChunk(&_s6.next_free_map_element_pointer_index, 3048816);
         }
 
+        // Parks that outgrew the RCT2 map elements carry the rest in an extra chunk
+        _extraMapElements.clear();
+        if (_s6.header.num_extra_map_elements > 0)
+        {
+            if (_s6.header.num_extra_map_elements > MAX_MAP_ELEMENTS_EXTENDED - MAX_MAP_ELEMENTS)
+            {
+                throw IOException("Too many map elements.");
+            }
+            _extraMapElements.resize(_s6.header.num_extra_map_elements);
+            chunkReader.ReadChunk(_extraMapElements.data(), _extraMapElements.size() * sizeof(rct_map_element));
+        }
+
         auto missingObjects = _objectManager->GetInvalidObjects(_s6.objects);
         if (missingObjects.size() > 0)
         {
@@ -197,7 +211,15 @@ public:
         gScenarioSrand0    = _s6.scenario_srand_0;
         gScenarioSrand1    = _s6.scenario_srand_1;
 
-        memcpy(gMapElements, _s6.map_elements, sizeof(_s6.map_elements));
+        if (!map_element_reserve(MAX_MAP_ELEMENTS + (uint32)_extraMapElements.size()))
+        {
+            throw Exception("Unable to allocate memory for map elements.");
+        }
+        memcpy(gMapElements, _s6.map_elements, MAX_MAP_ELEMENTS * sizeof(rct_map_element));
+        if (_extraMapElements.size() > 0)
+        {
+            memcpy(gMapElements + MAX_MAP_ELEMENTS, _extraMapElements.data(), _extraMapElements.size() * sizeof(rct_map_element));
+        }
 
         gNextFreeMapElementPointerIndex = _s6.next_free_map_element_pointer_index;
         for (sint32 i = 0; i < RCT2_MAX_SPRITES; i++)
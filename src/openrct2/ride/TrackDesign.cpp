@@ -40,11 +40,13 @@
 #include "track_data.h"
 #include "TrackDesign.h"
 
+// Elements the preview map has room for per byte of the elements of a design, on top of the surface of each tile. Each
+// piece, entrance or scenery item takes at least two bytes and places elements on at most 16 tiles, and inserting an
+// element copies the others of its tile, so twice that.
+#define TRACK_PREVIEW_MAP_ELEMENTS_PER_DESIGN_BYTE 16
+
 typedef struct map_backup
 {
-    rct_map_element map_elements[MAX_MAP_ELEMENTS];
-    rct_map_element * tile_pointers[MAX_TILE_MAP_ELEMENT_POINTERS];
-    rct_map_element * next_free_map_element;
     uint16          map_size_units;
     uint16          map_size_units_minus_2;
     uint16          map_size;
@@ -72,7 +74,11 @@ static bool _trackDesignPlaceStatePlaceScenery       = true;
 
 static rct_track_td6 * track_design_open_from_buffer(uint8 * src, size_t srcLength);
 
-static map_backup * track_design_preview_backup_map();
+static map_element_store *   _trackDesignPreviewMap           = nullptr;
+static ride_tile_index *     _trackDesignPreviewRideTileIndex = nullptr;
+static peep_pathfind_cache * _trackDesignPreviewPathFindCache = nullptr;
+
+static bool track_design_preview_backup_map(map_backup * backup, const rct_track_td6 * td6);
 
 static void track_design_preview_restore_map(map_backup * backup);
 
@@ -2111,6 +2117,7 @@ static money32 place_maze_design(uint8 flags, uint8 rideIndex, uint16 mazeEntry,
         mapElement->properties.track.type       = TRACK_ELEM_MAZE;
         mapElement->properties.track.ride_index = rideIndex;
         mapElement->properties.track.maze_entry = mazeEntry;
+        ride_tile_index_add(fx >> 5, fy >> 5, rideIndex);
         if (flags & GAME_COMMAND_FLAG_GHOST)
         {
             mapElement->flags |= MAP_ELEMENT_FLAG_GHOST;
@@ -2172,9 +2179,9 @@ void game_command_place_maze_design(sint32 * eax, sint32 * ebx, sint32 * ecx, si
  */
 void track_design_draw_preview(rct_track_td6 * td6, uint8 * pixels)
 {
-    // Make a copy of the map
-    map_backup * mapBackup = track_design_preview_backup_map();
-    if (mapBackup == NULL)
+    // Switch to the preview map, the map of the park is left as it is
+    map_backup mapBackup;
+    if (!track_design_preview_backup_map(&mapBackup, td6))
     {
         return;
     }
@@ -2191,7 +2198,7 @@ void track_design_draw_preview(rct_track_td6 * td6, uint8 * pixels)
     if (!track_design_place_preview(td6, &cost, &rideIndex, &flags))
     {
         memset(pixels, 0, TRACK_PREVIEW_IMAGE_SIZE * 4);
-        track_design_preview_restore_map(mapBackup);
+        track_design_preview_restore_map(&mapBackup);
         return;
     }
     td6->cost        = cost;
@@ -2267,65 +2274,82 @@ void track_design_draw_preview(rct_track_td6 * td6, uint8 * pixels)
     }
 
     ride_delete(rideIndex);
-    track_design_preview_restore_map(mapBackup);
+    track_design_preview_restore_map(&mapBackup);
+}
+
+/**
+ * Frees the map the previews are placed in, it is created again for the next preview.
+ */
+void track_design_preview_dispose()
+{
+    map_element_store_free(_trackDesignPreviewMap);
+    _trackDesignPreviewMap = nullptr;
+    ride_tile_index_free(_trackDesignPreviewRideTileIndex);
+    _trackDesignPreviewRideTileIndex = nullptr;
+    peep_pathfind_cache_free(_trackDesignPreviewPathFindCache);
+    _trackDesignPreviewPathFindCache = nullptr;
 }
 
 /**
- * Create a backup of the map as it will be cleared for drawing the track
- * design preview.
+ * Swaps the map of the park for the map the preview is placed in, keeping the settings of the park's map. The indexes
+ * derived from the map are swapped along with it, so those of the park are kept as they are.
  *  rct2: 0x006D1C68
  */
-static map_backup * track_design_preview_backup_map()
+static bool track_design_preview_backup_map(map_backup * backup, const rct_track_td6 * td6)
 {
-    map_backup * backup = (map_backup *) malloc(sizeof(map_backup));
-    if (backup != NULL)
-    {
-        memcpy(
-            backup->map_elements,
-            gMapElements,
-            sizeof(backup->map_elements)
-        );
-        memcpy(
-            backup->tile_pointers,
-            gMapElementTilePointers,
-            sizeof(backup->tile_pointers)
-        );
-        backup->next_free_map_element  = gNextFreeMapElement;
-        backup->map_size_units         = gMapSizeUnits;
-        backup->map_size_units_minus_2 = gMapSizeMinus2;
-        backup->map_size               = gMapSize;
-        backup->current_rotation       = get_current_rotation();
-    }
-    return backup;
+    uint32 numElements = MAX_TILE_MAP_ELEMENT_POINTERS + (uint32)td6->elementsSize * TRACK_PREVIEW_MAP_ELEMENTS_PER_DESIGN_BYTE;
+    numElements = Math::Min<uint32>(numElements, MAX_MAP_ELEMENTS_EXTENDED);
+    if (_trackDesignPreviewMap != nullptr && map_element_store_get_capacity(_trackDesignPreviewMap) < numElements)
+    {
+        // Made again at the size of the design rather than grown by doubling like the park's store
+        map_element_store_free(_trackDesignPreviewMap);
+        _trackDesignPreviewMap = nullptr;
+    }
+    if (_trackDesignPreviewMap == nullptr)
+    {
+        _trackDesignPreviewMap = map_element_store_create(numElements);
+    }
+    if (_trackDesignPreviewRideTileIndex == nullptr)
+    {
+        _trackDesignPreviewRideTileIndex = ride_tile_index_create();
+    }
+    if (_trackDesignPreviewPathFindCache == nullptr)
+    {
+        _trackDesignPreviewPathFindCache = peep_pathfind_cache_create();
+    }
+    if (_trackDesignPreviewMap == nullptr || _trackDesignPreviewRideTileIndex == nullptr || _trackDesignPreviewPathFindCache == nullptr)
+    {
+        return false;
+    }
+
+    backup->map_size_units         = gMapSizeUnits;
+    backup->map_size_units_minus_2 = gMapSizeMinus2;
+    backup->map_size               = gMapSize;
+    backup->current_rotation       = get_current_rotation();
+    map_element_store_swap(_trackDesignPreviewMap);
+    ride_tile_index_swap(_trackDesignPreviewRideTileIndex);
+    peep_pathfind_cache_swap(_trackDesignPreviewPathFindCache);
+    return true;
 }
 
 /**
- * Restores the map from a backup.
+ * Swaps the map of the park back in.
  *  rct2: 0x006D2378
  */
 static void track_design_preview_restore_map(map_backup * backup)
 {
-    memcpy(
-        gMapElements,
-        backup->map_elements,
-        sizeof(backup->map_elements)
-    );
-    memcpy(
-        gMapElementTilePointers,
-        backup->tile_pointers,
-        sizeof(backup->tile_pointers)
-    );
-    gNextFreeMapElement = backup->next_free_map_element;
+    map_element_store_swap(_trackDesignPreviewMap);
+    ride_tile_index_swap(_trackDesignPreviewRideTileIndex);
+    peep_pathfind_cache_swap(_trackDesignPreviewPathFindCache);
     gMapSizeUnits       = backup->map_size_units;
     gMapSizeMinus2      = backup->map_size_units_minus_2;
     gMapSize            = backup->map_size;
     gCurrentRotation    = backup->current_rotation;
-
-    free(backup);
 }
 
 /**
- * Resets all the map elements to surface tiles for track preview.
+ * Resets the preview map to a surface tile for each tile. Each tile keeps its surface at the same index of the
+ * elements, so only the tiles the last design was placed on have to be reset.
  *  rct2: 0x006D1D9A
  */
 static void track_design_preview_clear_map()
@@ -2336,19 +2360,31 @@ static void track_design_preview_clear_map()
     gMapSizeMinus2 = (264 * 32) - 2;
     gMapSize       = 256;
 
+    rct_map_element surface = {};
+    surface.type                            = MAP_ELEMENT_TYPE_SURFACE;
+    surface.flags                           = MAP_ELEMENT_FLAG_LAST_TILE;
+    surface.base_height                     = 2;
+    surface.clearance_height                = 0;
+    surface.properties.surface.slope        = 0;
+    surface.properties.surface.terrain      = 0;
+    surface.properties.surface.grass_length = GRASS_LENGTH_CLEAR_0;
+    surface.properties.surface.ownership    = OWNERSHIP_OWNED;
+
     for (sint32 i = 0; i < MAX_TILE_MAP_ELEMENT_POINTERS; i++)
     {
         rct_map_element * map_element = &gMapElements[i];
-        map_element->type                            = MAP_ELEMENT_TYPE_SURFACE;
-        map_element->flags                           = MAP_ELEMENT_FLAG_LAST_TILE;
-        map_element->base_height                     = 2;
-        map_element->clearance_height                = 0;
-        map_element->properties.surface.slope        = 0;
-        map_element->properties.surface.terrain      = 0;
-        map_element->properties.surface.grass_length = GRASS_LENGTH_CLEAR_0;
-        map_element->properties.surface.ownership    = OWNERSHIP_OWNED;
-    }
-    map_update_tile_pointers();
+        if (gMapElementTilePointers[i] != map_element || memcmp(map_element, &surface, sizeof(rct_map_element)) != 0)
+        {
+            *map_element = surface;
+            gMapElementTilePointers[i] = map_element;
+        }
+    }
+    gNextFreeMapElement = gMapElements + MAX_TILE_MAP_ELEMENT_POINTERS;
+    map_element_allocator_reset();
+
+    // These are the preview map's own, swapped in by track_design_preview_backup_map
+    ride_tile_index_invalidate();
+    peep_pathfind_cache_invalidate();
 }
 
 bool track_design_are_entrance_and_exit_placed()
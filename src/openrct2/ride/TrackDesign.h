@@ -226,6 +226,7 @@ void game_command_place_maze_design(sint32* eax, sint32* ebx, sint32* ecx, sint3
 // Track design preview
 ///////////////////////////////////////////////////////////////////////////////
 void track_design_draw_preview(rct_track_td6 *td6, uint8 *pixels);
+void track_design_preview_dispose();
 
 ///////////////////////////////////////////////////////////////////////////////
 // Track design saving
@@ -1196,6 +1196,15 @@ sint32 get_booster_speed(uint8 rideType, sint32 rawSpeed);
 void fix_invalid_vehicle_sprite_sizes();
 bool ride_entry_has_category(const rct_ride_entry * rideEntry, uint8 category);
 
+typedef struct ride_tile_index ride_tile_index;
+ride_tile_index *ride_tile_index_create();
+void ride_tile_index_swap(ride_tile_index *index);
+void ride_tile_index_free(ride_tile_index *index);
+void ride_tile_index_invalidate();
+void ride_tile_index_add(sint32 tileX, sint32 tileY, uint8 rideIndex);
+void ride_tile_index_remove(uint8 rideIndex);
+void ride_get_rides_with_track_near(sint32 tileX, sint32 tileY, sint32 radius, uint32 *rideBitmap);
+
 #ifdef __cplusplus
 }
 #endif
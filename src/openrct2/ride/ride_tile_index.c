@@ -0,0 +1,236 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+
+#include "../world/map.h"
+#include "ride.h"
+
+/**
+ * Index of the tiles each ride has track on, so that finding the rides near a location does not require walking
+ * every map element around it. Placing track adds its tile to the ride. Removing track only marks the ride, whose
+ * tiles are checked again the next time it is looked up, as the tile of the removed element is not known. The whole
+ * index is only rebuilt from the map after the map has been replaced, such as when loading a park. An element store
+ * swapped in for a while, like the one track design previews are placed in, has its own index swapped in with it.
+ */
+
+typedef struct ride_tile_list {
+    rct_xy8 * tiles;
+    uint32 count;
+    uint32 capacity;
+    // Bounds of the tiles, these only grow until the tiles are checked again
+    rct_xy8 min;
+    rct_xy8 max;
+    bool check_tiles;
+} ride_tile_list;
+
+struct ride_tile_index {
+    ride_tile_list lists[256];
+    bool valid;
+};
+
+static ride_tile_list _rideTileLists[256];
+static bool _rideTileIndexValid = false;
+
+/**
+ * Creates an empty index, to be swapped in along with the element store it is for.
+ */
+ride_tile_index *ride_tile_index_create()
+{
+    return calloc(1, sizeof(ride_tile_index));
+}
+
+/**
+ * Exchanges the index in use with the given one, the tiles of the lists are not copied.
+ */
+void ride_tile_index_swap(ride_tile_index *index)
+{
+    ride_tile_index current;
+    memcpy(current.lists, _rideTileLists, sizeof(_rideTileLists));
+    current.valid = _rideTileIndexValid;
+
+    memcpy(_rideTileLists, index->lists, sizeof(_rideTileLists));
+    _rideTileIndexValid = index->valid;
+
+    *index = current;
+}
+
+/**
+ * Frees an index created by ride_tile_index_create, which must not be swapped in.
+ */
+void ride_tile_index_free(ride_tile_index *index)
+{
+    if (index == NULL) {
+        return;
+    }
+    for (sint32 i = 0; i < 256; i++) {
+        free(index->lists[i].tiles);
+    }
+    free(index);
+}
+
+/**
+ * Drops the whole index, it is rebuilt from the map when next used. Only needed when the map has been replaced.
+ */
+void ride_tile_index_invalidate()
+{
+    _rideTileIndexValid = false;
+}
+
+static void ride_tile_list_push(ride_tile_list *list, sint32 x, sint32 y)
+{
+    if (list->count == list->capacity) {
+        uint32 newCapacity = list->capacity == 0 ? 16 : list->capacity * 2;
+        rct_xy8 *newTiles = realloc(list->tiles, newCapacity * sizeof(rct_xy8));
+        if (newTiles == NULL) {
+            log_error("Unable to allocate memory for ride tile index.");
+            _rideTileIndexValid = false;
+            return;
+        }
+        list->tiles = newTiles;
+        list->capacity = newCapacity;
+    }
+
+    rct_xy8 *tile = &list->tiles[list->count++];
+    tile->x = x;
+    tile->y = y;
+    list->min.x = min(list->min.x, x);
+    list->min.y = min(list->min.y, y);
+    list->max.x = max(list->max.x, x);
+    list->max.y = max(list->max.y, y);
+}
+
+static void ride_tile_list_clear(ride_tile_list *list)
+{
+    list->count = 0;
+    list->min.xy = 0xFFFF;
+    list->max.xy = 0;
+    list->check_tiles = false;
+}
+
+static bool ride_has_track_on_tile(sint32 x, sint32 y, uint8 rideIndex)
+{
+    rct_map_element *mapElement = map_get_first_element_at(x, y);
+    do {
+        if (map_element_get_type(mapElement) != MAP_ELEMENT_TYPE_TRACK) continue;
+        if (mapElement->properties.track.ride_index == rideIndex) return true;
+    } while (!map_element_is_last_for_tile(mapElement++));
+    return false;
+}
+
+/**
+ * Drops the tiles the ride no longer has track on after track of the ride has been removed.
+ */
+static void ride_tile_list_check(ride_tile_list *list, uint8 rideIndex)
+{
+    uint32 count = list->count;
+    ride_tile_list_clear(list);
+    for (uint32 i = 0; i < count; i++) {
+        rct_xy8 tile = list->tiles[i];
+        if (ride_has_track_on_tile(tile.x, tile.y, rideIndex)) {
+            ride_tile_list_push(list, tile.x, tile.y);
+        }
+    }
+}
+
+static void ride_tile_index_build()
+{
+    uint16 lastTile[256];
+    for (sint32 i = 0; i < 256; i++) {
+        ride_tile_list_clear(&_rideTileLists[i]);
+        lastTile[i] = 0xFFFF;
+    }
+    _rideTileIndexValid = true;
+
+    // Elements of a tile are all visited before moving on to the next tile, so a tile is only added once per ride
+    for (sint32 y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++) {
+        for (sint32 x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++) {
+            uint16 tile = (uint16)(x | (y << 8));
+            rct_map_element *mapElement = map_get_first_element_at(x, y);
+            do {
+                if (map_element_get_type(mapElement) != MAP_ELEMENT_TYPE_TRACK) continue;
+
+                uint8 rideIndex = mapElement->properties.track.ride_index;
+                if (lastTile[rideIndex] != tile) {
+                    lastTile[rideIndex] = tile;
+                    ride_tile_list_push(&_rideTileLists[rideIndex], x, y);
+                }
+            } while (!map_element_is_last_for_tile(mapElement++));
+        }
+    }
+}
+
+/**
+ * Records that the ride has track on the given tile, called whenever a track element is placed.
+ */
+void ride_tile_index_add(sint32 tileX, sint32 tileY, uint8 rideIndex)
+{
+    if (!_rideTileIndexValid) {
+        return;
+    }
+
+    ride_tile_list *list = &_rideTileLists[rideIndex];
+    for (uint32 i = 0; i < list->count; i++) {
+        if (list->tiles[i].x == tileX && list->tiles[i].y == tileY) {
+            return;
+        }
+    }
+    ride_tile_list_push(list, tileX, tileY);
+}
+
+/**
+ * Records that a track element of the ride has been removed, called by map_element_remove.
+ */
+void ride_tile_index_remove(uint8 rideIndex)
+{
+    _rideTileLists[rideIndex].check_tiles = true;
+}
+
+/**
+ * Sets the bit of every ride that has track within radius tiles of the given tile (in both x and y), the same set
+ * of rides that would be found by checking every track element in that square.
+ *  rideBitmap: must hold 256 bits
+ */
+void ride_get_rides_with_track_near(sint32 tileX, sint32 tileY, sint32 radius, uint32 *rideBitmap)
+{
+    if (!_rideTileIndexValid) {
+        ride_tile_index_build();
+    }
+
+    for (sint32 i = 0; i < 8; i++) {
+        rideBitmap[i] = 0;
+    }
+
+    sint32 left = tileX - radius;
+    sint32 top = tileY - radius;
+    sint32 right = tileX + radius;
+    sint32 bottom = tileY + radius;
+    for (sint32 rideIndex = 0; rideIndex < 256; rideIndex++) {
+        ride_tile_list *list = &_rideTileLists[rideIndex];
+        if (list->count == 0) continue;
+        if (list->max.x < left || list->min.x > right || list->max.y < top || list->min.y > bottom) continue;
+
+        if (list->check_tiles) {
+            ride_tile_list_check(list, (uint8)rideIndex);
+        }
+        for (uint32 i = 0; i < list->count; i++) {
+            const rct_xy8 *rideTile = &list->tiles[i];
+            if (rideTile->x >= left && rideTile->x <= right && rideTile->y >= top && rideTile->y <= bottom) {
+                rideBitmap[rideIndex >> 5] |= (1u << (rideIndex & 0x1F));
+                break;
+            }
+        }
+    }
+}
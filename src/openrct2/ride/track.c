@@ -1328,6 +1328,7 @@ static money32 track_place(sint32 rideIndex, sint32 type, sint32 originX, sint32
 
         map_element_set_track_sequence(mapElement, trackBlock->index);
         mapElement->properties.track.ride_index = rideIndex;
+        ride_tile_index_add(x / 32, y / 32, rideIndex);
         mapElement->properties.track.type = type;
         mapElement->properties.track.colour = 0;
         if (flags & GAME_COMMAND_FLAG_GHOST){
@@ -1853,6 +1854,7 @@ static money32 set_maze_track(uint16 x, uint8 flags, uint8 direction, uint16 y,
         mapElement->properties.track.type = TRACK_ELEM_MAZE;
         mapElement->properties.track.ride_index = rideIndex;
         mapElement->properties.track.maze_entry = 0xFFFF;
+        ride_tile_index_add(x / 32, y / 32, rideIndex);
 
         if (flags & GAME_COMMAND_FLAG_GHOST) {
             mapElement->flags |= MAP_ELEMENT_FLAG_GHOST;
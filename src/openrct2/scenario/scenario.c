@@ -731,11 +731,13 @@ static sint32 scenario_write_available_objects(FILE *file)
 
 /**
  * Modifies the given S6 data so that ghost elements, rides with no track elements or unused banners / user strings are saved.
+ * The map elements without the ghost elements are written to destination, which must have room for all elements in use.
+ * Returns the number of elements written.
  */
-void scenario_fix_ghosts(rct_s6_data *s6)
+size_t scenario_fix_ghosts(rct_s6_data *s6, rct_map_element *destination)
 {
     // Remove all ghost elements
-    rct_map_element *destinationElement = s6->map_elements;
+    rct_map_element *destinationElement = destination;
 
     for (sint32 y = 0; y < 256; y++) {
         for (sint32 x = 0; x < 256; x++) {
@@ -760,6 +762,7 @@ void scenario_fix_ghosts(rct_s6_data *s6)
             (destinationElement - 1)->flags |= MAP_ELEMENT_FLAG_LAST_TILE;
         }
     }
+    return (size_t)(destinationElement - destination);
 }
 
 void scenario_remove_trackless_rides(rct_s6_data *s6)
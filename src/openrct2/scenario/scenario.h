@@ -44,7 +44,8 @@ typedef struct rct_s6_header {
     uint16 num_packed_objects;  // 0x02
     uint32 version;             // 0x04
     uint32 magic_number;        // 0x08
-    uint8 pad_0C[0x14];
+    uint32 num_extra_map_elements; // 0x0C, OpenRCT2: elements that did not fit in map_elements, saved in an extra chunk
+    uint8 pad_10[0x10];
 } rct_s6_header;
 assert_struct_size(rct_s6_header, 0x20);
 
@@ -412,8 +413,10 @@ uint32 scenario_rand_max(uint32 max);
 
 bool scenario_prepare_for_save();
 sint32 scenario_save(const utf8 * path, sint32 flags);
+void scenario_autosave(const utf8 * path, const utf8 * backupPath, const utf8 * pattern, size_t numberOfFilesToKeep, sint32 flags);
+void scenario_autosave_wait();
 void scenario_remove_trackless_rides(rct_s6_data *s6);
-void scenario_fix_ghosts(rct_s6_data *s6);
+size_t scenario_fix_ghosts(rct_s6_data *s6, rct_map_element *destination);
 void scenario_failure();
 void scenario_success();
 void scenario_success_submit_name(const char *name);
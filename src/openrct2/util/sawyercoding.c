@@ -14,6 +14,10 @@
  *****************************************************************************/
 #pragma endregion
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 #include "../platform/platform.h"
 #include "sawyercoding.h"
 #include "../scenario/scenario.h"
@@ -319,117 +323,222 @@ static void decode_chunk_rotate(uint8 *buffer, size_t length)
 
 #pragma region Encoding
 
+/**
+ * The encoders compare the source a word of 8 bytes at a time. A word covers the longest repeat, finds the next pair of
+ * equal bytes for the RLE encoding, and tells which of 8 earlier bytes a repeat can start from.
+ */
+
+static uint64 encode_read_word(const uint8 *src)
+{
+    uint64 word;
+    memcpy(&word, src, sizeof(word));
+    return word;
+}
+
+/**
+ * Returns the index of the first byte in memory order that is set in the given non-zero word.
+ */
+static uint32 encode_first_set_byte(uint64 word)
+{
+#if defined(__GNUC__)
+    return (uint32)__builtin_ctzll(word) / 8;
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return (uint32)index / 8;
+#else
+    uint32 index = 0;
+    while ((word & 0xFF) == 0) {
+        word >>= 8;
+        index++;
+    }
+    return index;
+#endif
+}
+
+/**
+ * Returns a word with the top bit set in each byte that is zero in the given word.
+ */
+static uint64 encode_zero_bytes(uint64 word)
+{
+    const uint64 low7Bits = 0x7F7F7F7F7F7F7F7FULL;
+    return ~(((word & low7Bits) + low7Bits) | word | low7Bits);
+}
+
+/**
+ * Returns the number of bytes the two sequences have in common at their start, up to 8.
+ */
+static size_t encode_match_length(const uint8 *a, const uint8 *b)
+{
+    uint64 difference = encode_read_word(a) ^ encode_read_word(b);
+    if (difference == 0) {
+        return 8;
+    }
+    return encode_first_set_byte(difference);
+}
+
+/**
+ * Returns the first index from start on where a byte is followed by the same byte, or end if there is none before it.
+ * Index end + 1 must be inside the buffer.
+ */
+static size_t encode_find_pair(const uint8 *src, size_t start, size_t end)
+{
+    size_t i = start;
+    for (; i + 8 <= end; i += 8) {
+        uint64 pairs = encode_zero_bytes(encode_read_word(src + i) ^ encode_read_word(src + i + 1));
+        if (pairs != 0) {
+            return i + encode_first_set_byte(pairs);
+        }
+    }
+    for (; i < end; i++) {
+        if (src[i] == src[i + 1]) {
+            return i;
+        }
+    }
+    return end;
+}
+
+static uint8 *encode_rle_literal(uint8 *dst, const uint8 *src, size_t count)
+{
+    *dst++ = (uint8)(count - 1);
+    memcpy(dst, src, count);
+    return dst + count;
+}
+
 /**
  * Ensure dst_buffer is bigger than src_buffer then resize afterwards
  * returns length of dst_buffer
+ * Runs are at most 125 bytes. Literals are cut at 126 bytes, except the last one, which can take one more byte.
  */
 static size_t encode_chunk_rle(const uint8 *src_buffer, uint8 *dst_buffer, size_t length)
 {
-    const uint8* src = src_buffer;
-    uint8* dst = dst_buffer;
-    const uint8* end_src = src + length;
-    uint8 count = 0;
-    const uint8* src_norm_start = src;
-
-    while (src < end_src - 1){
-
-        if ((count && *src == src[1]) || count > 125){
-            *dst++ = count - 1;
-            memcpy(dst, src_norm_start, count);
-            dst += count;
-            src_norm_start += count;
-            count = 0;
-        }
-        if (*src == src[1]){
-            for (; (count < 125) && ((src + count) < end_src); count++){
-                if (*src != src[count]) break;
+    if (length == 0)
+        return 0;
+
+    uint8 *dst = dst_buffer;
+    size_t i = 0;
+    size_t count = 0;
+    while (i < length - 1) {
+        size_t pair = encode_find_pair(src_buffer, i, length - 1);
+
+        // Copy the bytes before the pair, or the end, as literals
+        while (i < pair) {
+            if (count > 125) {
+                dst = encode_rle_literal(dst, src_buffer + i - count, count);
+                count = 0;
             }
-            *dst++ = 257 - count;
-            *dst++ = *src;
-            src += count;
-            src_norm_start = src;
+            size_t literalCount = min(pair - i, 126 - count);
+            count += literalCount;
+            i += literalCount;
+        }
+        if (i == length - 1) {
+            break;
+        }
+
+        if (count != 0) {
+            dst = encode_rle_literal(dst, src_buffer + i - count, count);
             count = 0;
         }
-        else{
-            count++;
-            src++;
+        size_t runCount = 2;
+        while (runCount < 125 && i + runCount < length && src_buffer[i + runCount] == src_buffer[i]) {
+            runCount++;
         }
+        *dst++ = (uint8)(257 - runCount);
+        *dst++ = src_buffer[i];
+        i += runCount;
+    }
+    if (i == length - 1) {
+        count++;
     }
-    if (src == end_src - 1)count++;
-    if (count){
-        *dst++ = count - 1;
-        memcpy(dst, src_norm_start, count);
-        dst += count;
-        src_norm_start += count;
-        count = 0;
+    if (count != 0) {
+        dst = encode_rle_literal(dst, src_buffer + length - count, count);
     }
     return dst - dst_buffer;
 }
 
+/**
+ * Repeats copy 1 to 8 bytes from 1 to 32 bytes back, but never more bytes than they go back. The longest repeat is
+ * used, of those the one furthest back.
+ */
 static size_t encode_chunk_repeat(const uint8 *src_buffer, uint8 *dst_buffer, size_t length)
 {
     if (length == 0)
         return 0;
 
-    size_t outLength = 0;
+    uint8 *dst = dst_buffer;
 
     // Need to emit at least one byte, otherwise there is nothing to repeat
-    *dst_buffer++ = 255;
-    *dst_buffer++ = src_buffer[0];
-    outLength += 2;
+    *dst++ = 255;
+    *dst++ = src_buffer[0];
 
     // Iterate through remainder of the source buffer
     for (size_t i = 1; i < length; ) {
-        size_t searchIndex = (i < 32) ? 0 : (i - 32);
-        size_t searchEnd = i - 1;
-
-        size_t bestRepeatIndex = 0;
-        size_t bestRepeatCount = 0;
-        for (size_t repeatIndex = searchIndex; repeatIndex <= searchEnd; repeatIndex++) {
-            size_t repeatCount = 0;
-            size_t maxRepeatCount = min(min(7, searchEnd - repeatIndex), length - i - 1);
-            // maxRepeatCount should not exceed length
-            assert(repeatIndex + maxRepeatCount < length);
-            assert(i + maxRepeatCount < length);
-            for (size_t j = 0; j <= maxRepeatCount; j++) {
-                if (src_buffer[repeatIndex + j] == src_buffer[i + j]) {
-                    repeatCount++;
-                } else {
-                    break;
+        size_t bestDistance = 0;
+        size_t bestCount = 0;
+        if (i >= 32 && i + 8 <= length) {
+            // Only the earlier bytes equal to this one can start a repeat, they are found 8 at a time from the furthest
+            uint64 pattern = src_buffer[i] * 0x0101010101010101ULL;
+            for (size_t block = 0; block < 32 && bestCount < 8; block += 8) {
+                uint64 starts = encode_zero_bytes(encode_read_word(src_buffer + i - 32 + block) ^ pattern);
+                while (starts != 0) {
+                    size_t distance = 32 - block - encode_first_set_byte(starts);
+                    starts &= starts - 1;
+
+                    size_t repeatCount = min(encode_match_length(src_buffer + i - distance, src_buffer + i), distance);
+                    if (repeatCount > bestCount) {
+                        bestDistance = distance;
+                        bestCount = repeatCount;
+
+                        // Maximum repeat count is 8
+                        if (repeatCount == 8)
+                            break;
+                    }
                 }
             }
-            if (repeatCount > bestRepeatCount) {
-                bestRepeatIndex = repeatIndex;
-                bestRepeatCount = repeatCount;
-
-                // Maximum repeat count is 8
-                if (repeatCount == 8)
-                    break;
+        } else {
+            size_t maxCount = min(8, length - i);
+            for (size_t distance = min(32, i); distance > 0; distance--) {
+                size_t repeatCount = 0;
+                while (repeatCount < min(distance, maxCount) &&
+                    src_buffer[i - distance + repeatCount] == src_buffer[i + repeatCount]
+                ) {
+                    repeatCount++;
+                }
+                if (repeatCount > bestCount) {
+                    bestDistance = distance;
+                    bestCount = repeatCount;
+                    if (repeatCount == 8)
+                        break;
+                }
             }
         }
 
-        if (bestRepeatCount == 0) {
-            *dst_buffer++ = 255;
-            *dst_buffer++ = src_buffer[i];
-            outLength += 2;
+        if (bestCount == 0) {
+            *dst++ = 255;
+            *dst++ = src_buffer[i];
             i++;
         } else {
-            *dst_buffer++ = (uint8)((bestRepeatCount - 1) | ((32 - (i - bestRepeatIndex)) << 3));
-            outLength++;
-            i += bestRepeatCount;
+            *dst++ = (uint8)((bestCount - 1) | ((32 - bestDistance) << 3));
+            i += bestCount;
         }
     }
 
-    return outLength;
+    return dst - dst_buffer;
 }
 
 static void encode_chunk_rotate(uint8 *buffer, size_t length)
 {
-    size_t i;
-    uint8 code = 1;
-    for (i = 0; i < length; i++) {
+    // The rotation goes 1, 3, 5, 7 and then starts over
+    size_t i = 0;
+    for (; i + 4 <= length; i += 4) {
+        buffer[i + 0] = rol8(buffer[i + 0], 1);
+        buffer[i + 1] = rol8(buffer[i + 1], 3);
+        buffer[i + 2] = rol8(buffer[i + 2], 5);
+        buffer[i + 3] = rol8(buffer[i + 3], 7);
+    }
+    for (uint8 code = 1; i < length; i++) {
         buffer[i] = rol8(buffer[i], code);
-        code = (code + 2) % 8;
+        code += 2;
     }
 }
 
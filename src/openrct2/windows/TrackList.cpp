@@ -166,6 +166,7 @@ static void window_track_list_close(rct_window *w)
     track_design_dispose(_loadedTrackDesign);
     _loadedTrackDesign = nullptr;
     SafeFree(_trackDesignPreviewPixels);
+    track_design_preview_dispose();
 
     // Dispose track list
     for (size_t i = 0; i < _trackDesignsCount; i++) {
@@ -843,18 +843,16 @@ void footpath_bridge_get_info_from_pos(sint32 screenX, sint32 screenY, sint32 *x
  */
 void footpath_remove_litter(sint32 x, sint32 y, sint32 z)
 {
-    uint16 spriteIndex = sprite_get_first_in_quadrant(x, y);
-    while (spriteIndex != SPRITE_INDEX_NULL) {
-        rct_litter *sprite = &get_sprite(spriteIndex)->litter;
-        uint16 nextSpriteIndex = sprite->next_in_quadrant;
-        if (sprite->linked_list_type_offset == SPRITE_LIST_LITTER * 2) {
-            sint32 distanceZ = abs(sprite->z - z);
-            if (distanceZ <= 32) {
-                invalidate_sprite_0((rct_sprite*)sprite);
-                sprite_remove((rct_sprite*)sprite);
-            }
+    sprite_spatial_query query;
+    rct_sprite *sprite;
+
+    sprite_spatial_query_begin_tile(&query, x, y, SPRITE_LIST_LITTER);
+    while ((sprite = sprite_spatial_query_next(&query)) != NULL) {
+        sint32 distanceZ = abs(sprite->litter.z - z);
+        if (distanceZ <= 32) {
+            invalidate_sprite_0(sprite);
+            sprite_remove(sprite);
         }
-        spriteIndex = nextSpriteIndex;
     }
 }
 
@@ -864,24 +862,23 @@ void footpath_remove_litter(sint32 x, sint32 y, sint32 z)
  */
 void footpath_interrupt_peeps(sint32 x, sint32 y, sint32 z)
 {
-    uint16 spriteIndex = sprite_get_first_in_quadrant(x, y);
-    while (spriteIndex != SPRITE_INDEX_NULL) {
-        rct_peep *peep = &get_sprite(spriteIndex)->peep;
-        uint16 nextSpriteIndex = peep->next_in_quadrant;
-        if (peep->linked_list_type_offset == SPRITE_LIST_PEEP * 2) {
-            if (peep->state == PEEP_STATE_SITTING || peep->state == PEEP_STATE_WATCHING) {
-                if (peep->z == z) {
-                    peep_decrement_num_riders(peep);
-                    peep->state = PEEP_STATE_WALKING;
-                    peep_window_state_update(peep);
-                    peep->destination_x = (peep->x & 0xFFE0) + 16;
-                    peep->destination_y = (peep->y & 0xFFE0) + 16;
-                    peep->destination_tolerence = 5;
-                    peep_update_current_action_sprite_type(peep);
-                }
+    sprite_spatial_query query;
+    rct_sprite *sprite;
+
+    sprite_spatial_query_begin_tile(&query, x, y, SPRITE_LIST_PEEP);
+    while ((sprite = sprite_spatial_query_next(&query)) != NULL) {
+        rct_peep *peep = &sprite->peep;
+        if (peep->state == PEEP_STATE_SITTING || peep->state == PEEP_STATE_WATCHING) {
+            if (peep->z == z) {
+                peep_decrement_num_riders(peep);
+                peep->state = PEEP_STATE_WALKING;
+                peep_window_state_update(peep);
+                peep->destination_x = (peep->x & 0xFFE0) + 16;
+                peep->destination_y = (peep->y & 0xFFE0) + 16;
+                peep->destination_tolerence = 5;
+                peep_update_current_action_sprite_type(peep);
             }
         }
-        spriteIndex = nextSpriteIndex;
     }
 }
 
@@ -27,6 +27,7 @@
 #include "../management/finance.h"
 #include "../network/network.h"
 #include "../OpenRCT2.h"
+#include "../peep/peep.h"
 #include "../ride/ride_data.h"
 #include "../ride/track.h"
 #include "../ride/track_data.h"
@@ -93,8 +94,10 @@ sint16 gMapSizeMaxXY;
 sint16 gMapBaseZ;
 
 #if defined(NO_RCT2)
-rct_map_element gMapElements[MAX_TILE_MAP_ELEMENT_POINTERS * 3];
-rct_map_element *gMapElementTilePointers[MAX_TILE_MAP_ELEMENT_POINTERS];
+static rct_map_element _mapElementsInitial[MAX_MAP_ELEMENTS];
+static rct_map_element *_mapElementTilePointersInitial[MAX_TILE_MAP_ELEMENT_POINTERS];
+rct_map_element *gMapElements = _mapElementsInitial;
+rct_map_element **gMapElementTilePointers = _mapElementTilePointersInitial;
 #else
 rct_map_element *gMapElements = RCT2_ADDRESS(RCT2_ADDRESS_MAP_ELEMENTS, rct_map_element);
 rct_map_element **gMapElementTilePointers = RCT2_ADDRESS(RCT2_ADDRESS_TILE_MAP_ELEMENT_POINTERS, rct_map_element*);
@@ -102,6 +105,7 @@ rct_map_element **gMapElementTilePointers = RCT2_ADDRESS(RCT2_ADDRESS_TILE_MAP_E
 rct_xy16 gMapSelectionTiles[300];
 rct2_peep_spawn gPeepSpawns[MAX_PEEP_SPAWNS];
 
+uint32 gMapElementsCapacity = MAX_MAP_ELEMENTS;
 rct_map_element *gNextFreeMapElement;
 uint32 gNextFreeMapElementPointerIndex;
 
@@ -466,7 +470,7 @@ void map_strip_ghost_flag_from_elements()
     rct_map_element *mapElement = gMapElements;
     do {
         mapElement->flags &= ~MAP_ELEMENT_FLAG_GHOST;
-    } while (++mapElement < gMapElements + MAX_MAP_ELEMENTS);
+    } while (++mapElement < gMapElements + gMapElementsCapacity);
 }
 
 /**
@@ -491,6 +495,11 @@ void map_update_tile_pointers()
     }
 
     gNextFreeMapElement = mapElement;
+    map_element_allocator_reset();
+
+    // Tile pointers are updated whenever the map has been replaced, i.e. cleared or loaded
+    ride_tile_index_invalidate();
+    peep_pathfind_cache_invalidate();
 }
 
 /**
@@ -640,55 +649,6 @@ sint32 map_element_height(sint32 x, sint32 y)
     return height;
 }
 
-/**
- *
- *  rct2: 0x0068B089
- */
-void sub_68B089()
-{
-    sint32 i;
-    rct_map_element *mapElementFirst, *mapElement;
-
-    if (gTrackDesignSaveMode)
-        return;
-
-    i = gNextFreeMapElementPointerIndex;
-    do {
-        i++;
-        if (i >= MAX_TILE_MAP_ELEMENT_POINTERS)
-            i = 0;
-    } while (gMapElementTilePointers[i] == TILE_UNDEFINED_MAP_ELEMENT);
-    gNextFreeMapElementPointerIndex = i;
-
-    mapElementFirst = mapElement = gMapElementTilePointers[i];
-    do {
-        mapElement--;
-        if (mapElement < gMapElements)
-            break;
-    } while (mapElement->base_height == 255);
-    mapElement++;
-
-    if (mapElement == mapElementFirst)
-        return;
-
-    //
-    gMapElementTilePointers[i] = mapElement;
-    do {
-        *mapElement = *mapElementFirst;
-        mapElementFirst->base_height = 255;
-
-        mapElementFirst++;
-    } while (!map_element_is_last_for_tile(mapElement++));
-
-    mapElement = gNextFreeMapElement;
-    do {
-        mapElement--;
-    } while (mapElement->base_height == 255);
-    mapElement++;
-    gNextFreeMapElement = mapElement;
-}
-
-
 /**
  * Checks if the tile at coordinate at height counts as connected.
  * @return 1 if connected, 0 otherwise
@@ -725,6 +685,27 @@ sint32 map_coord_is_connected(sint32 x, sint32 y, sint32 z, uint8 faceDirection)
  *
  *  rct2: 0x006A876D
  */
+/**
+ * Gets which elements of a tile are wide paths, one bit per element. Returns false if
+ * the tile has too many elements for the result to hold.
+ */
+static bool map_get_path_wide_flags(sint32 x, sint32 y, uint64 *wideFlags)
+{
+    *wideFlags = 0;
+    sint32 index = 0;
+    rct_map_element *mapElement = map_get_first_element_at(x / 32, y / 32);
+    do {
+        if (index >= 64) {
+            return false;
+        }
+        if (map_element_get_type(mapElement) == MAP_ELEMENT_TYPE_PATH && footpath_element_is_wide(mapElement)) {
+            *wideFlags |= 1ULL << index;
+        }
+        index++;
+    } while (!map_element_is_last_for_tile(mapElement++));
+    return true;
+}
+
 void map_update_path_wide_flags()
 {
     if (gScreenFlags & (SCREEN_FLAGS_TRACK_DESIGNER | SCREEN_FLAGS_TRACK_MANAGER)) {
@@ -737,7 +718,14 @@ void map_update_path_wide_flags()
     uint16 x = gWidePathTileLoopX;
     uint16 y = gWidePathTileLoopY;
     for (sint32 i = 0; i < 128; i++) {
+        // Wide paths are avoided by the pathfinding, so cached searches are only valid while they stay the same
+        uint64 wideFlagsBefore, wideFlagsAfter;
+        bool validBefore = map_get_path_wide_flags(x, y, &wideFlagsBefore);
         footpath_update_path_wide_flags(x, y);
+        bool validAfter = map_get_path_wide_flags(x, y, &wideFlagsAfter);
+        if (!validBefore || !validAfter || wideFlagsBefore != wideFlagsAfter) {
+            peep_pathfind_cache_invalidate();
+        }
 
         // Next x, y tile
         x += 32;
@@ -2934,6 +2922,13 @@ void map_element_decrement_onride_photo_timout(rct_map_element * mapElement)
  */
 void map_element_remove(rct_map_element *mapElement)
 {
+    if (map_element_get_type(mapElement) == MAP_ELEMENT_TYPE_TRACK) {
+        ride_tile_index_remove(mapElement->properties.track.ride_index);
+    }
+    peep_pathfind_cache_invalidate();
+    // The elements above it on the tile move down, so the kept hits of the pixels would point at other elements
+    viewport_pick_cache_invalidate();
+
     // Replace Nth element by (N+1)th element.
     // This loop will make mapElement point to the old last element position,
     // after copy it to it's new position
@@ -2945,11 +2940,7 @@ void map_element_remove(rct_map_element *mapElement)
 
     // Mark the latest element with the last element flag.
     (mapElement - 1)->flags |= MAP_ELEMENT_FLAG_LAST_TILE;
-    mapElement->base_height = 0xFF;
-
-    if ((mapElement + 1) == gNextFreeMapElement){
-        gNextFreeMapElement--;
-    }
+    map_element_free(mapElement, 1);
 }
 
 /**
@@ -3070,7 +3061,7 @@ void map_reorganise_elements()
 {
     context_setcurrentcursor(CURSOR_ZZZ);
 
-    rct_map_element* new_map_elements = malloc(3 * (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL) * sizeof(rct_map_element));
+    rct_map_element* new_map_elements = malloc(gMapElementsCapacity * sizeof(rct_map_element));
     rct_map_element* new_elements_pointer = new_map_elements;
 
     if (new_map_elements == NULL) {
@@ -3094,7 +3085,7 @@ void map_reorganise_elements()
 
     num_elements = (uint32)(new_elements_pointer - new_map_elements);
     memcpy(gMapElements, new_map_elements, num_elements * sizeof(rct_map_element));
-    memset(gMapElements + num_elements, 0, (3 * (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL) - num_elements) * sizeof(rct_map_element));
+    memset(gMapElements + num_elements, 0, (gMapElementsCapacity - num_elements) * sizeof(rct_map_element));
 
     free(new_map_elements);
 
@@ -3104,28 +3095,16 @@ void map_reorganise_elements()
 /**
  *
  *  rct2: 0x0068B044
- *  Returns true on space available for more elements
- *  Reorganises the map elements to check for space
+ *  Returns true if the next num_elements calls to map_element_insert are certain to find room
+ *  Nothing is reorganised or grown here, callers hold element pointers, see map_element_reserve_margin
  */
 bool map_check_free_elements_and_reorganise(sint32 num_elements)
 {
-    if ((gNextFreeMapElement + num_elements) <= gMapElements + MAX_MAP_ELEMENTS)
-        return true;
-
-    for (sint32 i = 1000; i != 0; --i)
-        sub_68B089();
-
-    if ((gNextFreeMapElement + num_elements) <= gMapElements + MAX_MAP_ELEMENTS)
+    if (map_element_can_insert((uint32)num_elements))
         return true;
 
-    map_reorganise_elements();
-
-    if ((gNextFreeMapElement + num_elements) <= gMapElements + MAX_MAP_ELEMENTS)
-        return true;
-    else{
-        gGameCommandErrorText = STR_ERR_LANDSCAPE_DATA_AREA_FULL;
-        return false;
-    }
+    gGameCommandErrorText = STR_ERR_LANDSCAPE_DATA_AREA_FULL;
+    return false;
 }
 
 /**
@@ -3136,13 +3115,25 @@ rct_map_element *map_element_insert(sint32 x, sint32 y, sint32 z, sint32 flags)
 {
     rct_map_element *originalMapElement, *newMapElement, *insertedElement;
 
-    if (!map_check_free_elements_and_reorganise(1)) {
+    originalMapElement = gMapElementTilePointers[y * MAXIMUM_MAP_SIZE_TECHNICAL + x];
+    sint32 numElements = 1;
+    for (rct_map_element *mapElement = originalMapElement; !map_element_is_last_for_tile(mapElement); mapElement++) {
+        numElements++;
+    }
+
+    // Other tiles are never moved to make room, callers may hold pointers to their elements
+    newMapElement = map_element_allocate(numElements + 1);
+    if (newMapElement == NULL) {
+        gGameCommandErrorText = STR_ERR_LANDSCAPE_DATA_AREA_FULL;
         log_error("Cannot insert new element");
         return NULL;
     }
 
-    newMapElement = gNextFreeMapElement;
-    originalMapElement = gMapElementTilePointers[y * MAXIMUM_MAP_SIZE_TECHNICAL + x];
+    peep_pathfind_cache_invalidate();
+    // The elements of the tile move to a new block, so the kept hits of the pixels would point at freed elements
+    viewport_pick_cache_invalidate();
+
+    rct_map_element *originalRun = originalMapElement;
 
     // Set tile index pointer to point to new element block
     gMapElementTilePointers[y * MAXIMUM_MAP_SIZE_TECHNICAL + x] = newMapElement;
@@ -3182,19 +3173,18 @@ rct_map_element *map_element_insert(sint32 x, sint32 y, sint32 z, sint32 flags)
         } while (!((newMapElement - 1)->flags & MAP_ELEMENT_FLAG_LAST_TILE));
     }
 
-    gNextFreeMapElement = newMapElement;
+    map_element_free(originalRun, numElements);
     return insertedElement;
 }
 
 /**
  * This function will validate element address. It will only check if element lies within
- * the user-accessible part of map elements, there is some scratch space behind that is not
- * considered valid here.
+ * the element store.
  */
 bool map_element_check_address(const rct_map_element * const element)
 {
     if (element >= gMapElements
-        && element < gMapElements + MAX_MAP_ELEMENTS
+        && element < gMapElements + gMapElementsCapacity
         // condition below checks alignment
         && gMapElements + (((uintptr_t)element - (uintptr_t)gMapElements) / sizeof(rct_map_element)) == element)
     {
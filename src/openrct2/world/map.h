@@ -284,7 +284,10 @@ enum
 #define MAP_MINIMUM_X_Y -MAXIMUM_MAP_SIZE_TECHNICAL
 #define MAP_LOCATION_NULL ((sint16)(uint16)0x8000)
 
+// Number of map elements that fit in an RCT2 park, the element store starts at this size and grows on demand
 #define MAX_MAP_ELEMENTS 196096 // 0x30000
+// The elements beyond MAX_MAP_ELEMENTS are saved in a single extra chunk, which limits how far the store can grow
+#define MAX_MAP_ELEMENTS_EXTENDED (MAX_MAP_ELEMENTS * 4)
 #define MAX_TILE_MAP_ELEMENT_POINTERS (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL)
 #define MAX_PEEP_SPAWNS 2
 #define PEEP_SPAWN_UNDEFINED 0xFFFF
@@ -408,13 +411,9 @@ extern uint8        gMapSelectArrowDirection;
 
 extern uint8 gMapGroundFlags;
 
-#ifdef NO_RCT2
-extern rct_map_element gMapElements[];
-extern rct_map_element *gMapElementTilePointers[];
-#else
 extern rct_map_element *gMapElements;
+extern uint32 gMapElementsCapacity;
 extern rct_map_element **gMapElementTilePointers;
-#endif
 
 extern rct_xy16 gMapSelectionTiles[300];
 extern rct2_peep_spawn gPeepSpawns[MAX_PEEP_SPAWNS];
@@ -463,7 +462,6 @@ rct_map_element *map_get_wall_element_at(sint32 x, sint32 y, sint32 z, sint32 di
 rct_map_element *map_get_small_scenery_element_at(sint32 x, sint32 y, sint32 z, sint32 type, uint8 quadrant);
 rct_map_element *map_get_park_entrance_element_at(sint32 x, sint32 y, sint32 z, bool ghost);
 sint32 map_element_height(sint32 x, sint32 y);
-void sub_68B089();
 sint32 map_coord_is_connected(sint32 x, sint32 y, sint32 z, uint8 faceDirection);
 void map_remove_provisional_elements();
 void map_restore_provisional_elements();
@@ -491,6 +489,19 @@ void map_invalidate_map_selection_tiles();
 void map_invalidate_selection_rect();
 void map_reorganise_elements();
 bool map_check_free_elements_and_reorganise(sint32 num_elements);
+void map_element_allocator_reset();
+bool map_element_reserve(uint32 numElements);
+void map_element_reserve_margin();
+bool map_element_can_insert(uint32 numInserts);
+uint32 map_element_get_free_count();
+rct_map_element *map_element_allocate(sint32 numElements);
+void map_element_free(rct_map_element *mapElement, sint32 numElements);
+
+typedef struct map_element_store map_element_store;
+map_element_store *map_element_store_create(uint32 capacity);
+void map_element_store_swap(map_element_store *store);
+uint32 map_element_store_get_capacity(const map_element_store *store);
+void map_element_store_free(map_element_store *store);
 rct_map_element *map_element_insert(sint32 x, sint32 y, sint32 z, sint32 flags);
 bool map_element_check_address(const rct_map_element * const element);
 
@@ -0,0 +1,611 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+
+#include "../interface/viewport.h"
+#include "map.h"
+
+/**
+ * Allocator for the runs of elements that make up each tile. Inserting an element moves the whole run of a tile to a
+ * new block one element larger, removing one shrinks the run, and the holes this leaves behind are kept in free lists
+ * so they can be reused straight away instead of waiting for the map elements to be compacted. Freed blocks are merged
+ * with the holes on either side, found through boundary tags, and a hole that ends at gNextFreeMapElement is given back
+ * to the space after the last used element.
+ *
+ * Runs are never moved while a game command may hold element pointers. An insert takes a hole when one fits and the
+ * space after the last used element otherwise, so map_element_can_insert only counts on that space. Between ticks,
+ * map_element_reserve_margin grows the store, or at its cap moves the last runs into holes, to keep that space large.
+ */
+
+// Holes of 1 to MAP_ELEMENT_FREE_LIST_COUNT - 1 elements have a list each, larger holes share the last list
+#define MAP_ELEMENT_FREE_LIST_COUNT 16
+// Free elements the store is grown to keep between game commands, more than a single command is expected to insert
+#define MAP_ELEMENT_FREE_MARGIN 0x8000
+
+typedef struct map_element_free_block {
+    uint32 start;
+    uint32 size;
+} map_element_free_block;
+
+typedef struct map_element_free_list {
+    map_element_free_block * blocks;
+    size_t count;
+    size_t capacity;
+} map_element_free_list;
+
+static map_element_free_list _mapElementFreeLists[MAP_ELEMENT_FREE_LIST_COUNT];
+static uint32 _mapElementFreeListTotal = 0;
+
+// Boundary tags of the holes, indexed by element: the size of a hole at its first element and its start + 1 at its last
+// element, 0 anywhere else. A free list entry whose hole has since been merged no longer matches and is dropped when
+// it comes up. Without tags, when they could not be allocated, holes are not merged.
+static uint32 *_mapElementHoleSizes = NULL;
+static uint32 *_mapElementHoleStarts = NULL;
+static uint32 _mapElementHoleTagsCapacity = 0;
+
+// Set once the element store has been moved to the heap, the initial store is not owned by the allocator
+static bool _mapElementsAllocated = false;
+
+// Upper bound of the number of elements on any tile, only lowered when all the runs are counted again
+static uint32 _mapElementLongestRun = 1;
+
+typedef struct map_element_run {
+    uint32 start;
+    uint32 size;
+    sint32 tile_index;
+} map_element_run;
+
+static map_element_free_list *map_element_get_free_list(uint32 size)
+{
+    if (size >= MAP_ELEMENT_FREE_LIST_COUNT) {
+        return &_mapElementFreeLists[0];
+    }
+    return &_mapElementFreeLists[size];
+}
+
+static bool map_element_hole_tags_available()
+{
+    return _mapElementHoleSizes != NULL && _mapElementHoleStarts != NULL && _mapElementHoleTagsCapacity >= gMapElementsCapacity;
+}
+
+static void map_element_hole_tags_set(uint32 start, uint32 size, uint32 sizeTag, uint32 startTag)
+{
+    if (map_element_hole_tags_available()) {
+        _mapElementHoleSizes[start] = sizeTag;
+        _mapElementHoleStarts[start + size - 1] = startTag;
+    }
+}
+
+static bool map_element_free_block_is_valid(map_element_free_block block)
+{
+    return !map_element_hole_tags_available() || _mapElementHoleSizes[block.start] == block.size;
+}
+
+static void map_element_free_list_push(uint32 start, uint32 size)
+{
+    map_element_free_list *list = map_element_get_free_list(size);
+    if (list->count == list->capacity) {
+        size_t newCapacity = list->capacity == 0 ? 256 : list->capacity * 2;
+        map_element_free_block *newBlocks = realloc(list->blocks, newCapacity * sizeof(map_element_free_block));
+        if (newBlocks == NULL) {
+            // The hole is only lost until the map elements are next reorganised
+            log_error("Unable to allocate memory for map element free list.");
+            return;
+        }
+        list->blocks = newBlocks;
+        list->capacity = newCapacity;
+    }
+
+    list->blocks[list->count].start = start;
+    list->blocks[list->count].size = size;
+    list->count++;
+    map_element_hole_tags_set(start, size, size, start + 1);
+    _mapElementFreeListTotal += size;
+}
+
+static map_element_free_block map_element_free_list_remove(map_element_free_list *list, size_t index)
+{
+    map_element_free_block block = list->blocks[index];
+    list->blocks[index] = list->blocks[list->count - 1];
+    list->count--;
+    return block;
+}
+
+static map_element_free_block map_element_free_list_take(map_element_free_list *list, size_t index)
+{
+    map_element_free_block block = map_element_free_list_remove(list, index);
+    map_element_hole_tags_set(block.start, block.size, 0, 0);
+    _mapElementFreeListTotal -= block.size;
+    return block;
+}
+
+/**
+ * Makes sure there are boundary tags for numElements elements, the new tags are cleared.
+ */
+static bool map_element_hole_tags_reserve(uint32 numElements)
+{
+    if (_mapElementHoleSizes != NULL && _mapElementHoleStarts != NULL && _mapElementHoleTagsCapacity >= numElements) {
+        return true;
+    }
+
+    uint32 oldCapacity = (_mapElementHoleSizes != NULL && _mapElementHoleStarts != NULL) ? _mapElementHoleTagsCapacity : 0;
+    uint32 *holeSizes = realloc(_mapElementHoleSizes, numElements * sizeof(uint32));
+    if (holeSizes == NULL) {
+        return false;
+    }
+    _mapElementHoleSizes = holeSizes;
+    uint32 *holeStarts = realloc(_mapElementHoleStarts, numElements * sizeof(uint32));
+    if (holeStarts == NULL) {
+        return false;
+    }
+    _mapElementHoleStarts = holeStarts;
+
+    memset(_mapElementHoleSizes + oldCapacity, 0, (numElements - oldCapacity) * sizeof(uint32));
+    memset(_mapElementHoleStarts + oldCapacity, 0, (numElements - oldCapacity) * sizeof(uint32));
+    _mapElementHoleTagsCapacity = numElements;
+    return true;
+}
+
+/**
+ * Stops merging holes. The entries of holes that were merged away are dropped first, as they can no longer be told
+ * apart once the tags are gone.
+ */
+static void map_element_hole_tags_dispose()
+{
+    if (map_element_hole_tags_available()) {
+        for (sint32 i = 0; i < MAP_ELEMENT_FREE_LIST_COUNT; i++) {
+            map_element_free_list *list = &_mapElementFreeLists[i];
+            for (size_t j = 0; j < list->count;) {
+                if (map_element_free_block_is_valid(list->blocks[j])) {
+                    j++;
+                } else {
+                    map_element_free_list_remove(list, j);
+                }
+            }
+        }
+    }
+
+    log_error("Unable to allocate memory for map element holes, they will not be merged.");
+    free(_mapElementHoleSizes);
+    free(_mapElementHoleStarts);
+    _mapElementHoleSizes = NULL;
+    _mapElementHoleStarts = NULL;
+    _mapElementHoleTagsCapacity = 0;
+}
+
+/**
+ * Rebuilds the free lists from the holes between the runs of the tiles, must be called whenever the map elements or
+ * the tile pointers have been replaced.
+ */
+void map_element_allocator_reset()
+{
+    for (sint32 i = 0; i < MAP_ELEMENT_FREE_LIST_COUNT; i++) {
+        _mapElementFreeLists[i].count = 0;
+    }
+    _mapElementFreeListTotal = 0;
+    viewport_pick_cache_invalidate();
+
+    if (map_element_hole_tags_reserve(gMapElementsCapacity)) {
+        memset(_mapElementHoleSizes, 0, _mapElementHoleTagsCapacity * sizeof(uint32));
+        memset(_mapElementHoleStarts, 0, _mapElementHoleTagsCapacity * sizeof(uint32));
+    } else {
+        map_element_hole_tags_dispose();
+    }
+
+    uint32 numElements = (uint32)(gNextFreeMapElement - gMapElements);
+    uint8 *used = calloc((numElements + 7) / 8, 1);
+    if (used == NULL) {
+        log_error("Unable to allocate memory for map element free list.");
+        return;
+    }
+
+    _mapElementLongestRun = 1;
+    for (sint32 i = 0; i < MAX_TILE_MAP_ELEMENT_POINTERS; i++) {
+        rct_map_element *mapElement = gMapElementTilePointers[i];
+        if (mapElement == TILE_UNDEFINED_MAP_ELEMENT) {
+            continue;
+        }
+        uint32 runSize = 0;
+        do {
+            uint32 index = (uint32)(mapElement - gMapElements);
+            if (index < numElements) {
+                used[index / 8] |= 1 << (index % 8);
+            }
+            runSize++;
+        } while (!map_element_is_last_for_tile(mapElement++));
+        _mapElementLongestRun = max(_mapElementLongestRun, runSize);
+    }
+
+    uint32 holeStart = 0;
+    uint32 holeSize = 0;
+    for (uint32 index = 0; index < numElements; index++) {
+        if (used[index / 8] & (1 << (index % 8))) {
+            if (holeSize != 0) {
+                map_element_free_list_push(holeStart, holeSize);
+                holeSize = 0;
+            }
+        } else {
+            if (holeSize == 0) {
+                holeStart = index;
+            }
+            gMapElements[index].base_height = 255;
+            holeSize++;
+        }
+    }
+    if (holeSize != 0) {
+        gNextFreeMapElement = gMapElements + holeStart;
+    }
+
+    free(used);
+}
+
+/**
+ * Grows the element store so it has room for at least numElements elements, doubling its size each time to keep the
+ * number of moves low. The free lists keep indices, so only the tile pointers have to be moved along. Returns false if
+ * the store would grow beyond MAX_MAP_ELEMENTS_EXTENDED or cannot be allocated.
+ *
+ * The old store is freed, so this must not be called while anything holds on to element pointers, i.e. only while
+ * loading a park or from map_element_reserve_margin.
+ */
+bool map_element_reserve(uint32 numElements)
+{
+    if (numElements <= gMapElementsCapacity) {
+        return true;
+    }
+    if (numElements > MAX_MAP_ELEMENTS_EXTENDED) {
+        return false;
+    }
+
+    uint32 newCapacity = max(numElements, min(gMapElementsCapacity * 2, MAX_MAP_ELEMENTS_EXTENDED));
+    rct_map_element *newMapElements = malloc(newCapacity * sizeof(rct_map_element));
+    if (newMapElements == NULL) {
+        log_error("Unable to allocate memory for map elements.");
+        return false;
+    }
+    if (map_element_hole_tags_available() && !map_element_hole_tags_reserve(newCapacity)) {
+        map_element_hole_tags_dispose();
+    }
+    memcpy(newMapElements, gMapElements, gMapElementsCapacity * sizeof(rct_map_element));
+    memset(newMapElements + gMapElementsCapacity, 0, (newCapacity - gMapElementsCapacity) * sizeof(rct_map_element));
+
+    for (sint32 i = 0; i < MAX_TILE_MAP_ELEMENT_POINTERS; i++) {
+        if (gMapElementTilePointers[i] != TILE_UNDEFINED_MAP_ELEMENT) {
+            gMapElementTilePointers[i] = newMapElements + (gMapElementTilePointers[i] - gMapElements);
+        }
+    }
+    gNextFreeMapElement = newMapElements + (gNextFreeMapElement - gMapElements);
+
+    if (_mapElementsAllocated) {
+        free(gMapElements);
+    }
+    log_verbose("Map element store grown from %u to %u elements", gMapElementsCapacity, newCapacity);
+    gMapElements = newMapElements;
+    gMapElementsCapacity = newCapacity;
+    _mapElementsAllocated = true;
+    viewport_pick_cache_invalidate();
+    return true;
+}
+
+static uint32 map_element_get_tail_count()
+{
+    return (uint32)((gMapElements + gMapElementsCapacity) - gNextFreeMapElement);
+}
+
+static int map_element_run_compare_start_descending(const void *a, const void *b)
+{
+    uint32 startA = ((const map_element_run *)a)->start;
+    uint32 startB = ((const map_element_run *)b)->start;
+    return startA < startB ? 1 : (startA > startB ? -1 : 0);
+}
+
+static bool map_element_take_hole(uint32 size, map_element_free_block *block);
+
+/**
+ * Moves the runs of the tiles at the end of the used elements into holes further down, until there are at least
+ * numElements elements after the last used one or the last run fits no hole. Only the runs near the end are looked
+ * at, so this is no full reorganisation, but it does move runs and may only be called from map_element_reserve_margin.
+ */
+static void map_element_compact_tail(uint32 numElements)
+{
+    uint32 nextFreeIndex = (uint32)(gNextFreeMapElement - gMapElements);
+    uint32 windowStart = nextFreeIndex - min(nextFreeIndex, numElements * 2);
+
+    map_element_run *runs = malloc(MAX_TILE_MAP_ELEMENT_POINTERS * sizeof(map_element_run));
+    if (runs == NULL) {
+        log_error("Unable to allocate memory for map element runs.");
+        return;
+    }
+    size_t numRuns = 0;
+    for (sint32 i = 0; i < MAX_TILE_MAP_ELEMENT_POINTERS; i++) {
+        rct_map_element *mapElement = gMapElementTilePointers[i];
+        if (mapElement == TILE_UNDEFINED_MAP_ELEMENT || (uint32)(mapElement - gMapElements) < windowStart) {
+            continue;
+        }
+        runs[numRuns].start = (uint32)(mapElement - gMapElements);
+        runs[numRuns].tile_index = i;
+        runs[numRuns].size = 1;
+        while (!map_element_is_last_for_tile(mapElement++)) {
+            runs[numRuns].size++;
+        }
+        numRuns++;
+    }
+    qsort(runs, numRuns, sizeof(map_element_run), map_element_run_compare_start_descending);
+
+    for (size_t i = 0; i < numRuns && map_element_get_tail_count() < numElements; i++) {
+        const map_element_run *run = &runs[i];
+        map_element_free_block block;
+        if (!map_element_take_hole(run->size, &block)) {
+            break;
+        }
+        if (block.start > run->start) {
+            // Only possible for holes that were not merged, moving up would not help
+            map_element_free(gMapElements + block.start, (sint32)block.size);
+            break;
+        }
+        if (block.size > run->size) {
+            map_element_free(gMapElements + block.start + run->size, (sint32)(block.size - run->size));
+        }
+
+        rct_map_element *oldRun = gMapElements + run->start;
+        memcpy(gMapElements + block.start, oldRun, run->size * sizeof(rct_map_element));
+        gMapElementTilePointers[run->tile_index] = gMapElements + block.start;
+        map_element_free(oldRun, (sint32)run->size);
+    }
+    free(runs);
+    viewport_pick_cache_invalidate();
+}
+
+/**
+ * Makes sure there are at least MAP_ELEMENT_FREE_MARGIN elements after the last used one, growing the element store
+ * or, once it is at its cap, moving the last runs into holes. Game commands never do either, as they hold element
+ * pointers while inserting, so this is called between ticks and frames.
+ */
+void map_element_reserve_margin()
+{
+    uint32 tailCount = map_element_get_tail_count();
+    if (tailCount >= MAP_ELEMENT_FREE_MARGIN) {
+        return;
+    }
+    if (gMapElementsCapacity < MAX_MAP_ELEMENTS_EXTENDED) {
+        map_element_reserve(min(gMapElementsCapacity + (MAP_ELEMENT_FREE_MARGIN - tailCount), MAX_MAP_ELEMENTS_EXTENDED));
+    }
+    if (map_element_get_tail_count() < MAP_ELEMENT_FREE_MARGIN && _mapElementFreeListTotal != 0) {
+        map_element_compact_tail(MAP_ELEMENT_FREE_MARGIN);
+    }
+}
+
+/**
+ * Returns whether the next numInserts calls to map_element_insert are certain to find room. Each insert moves the run
+ * of its tile to a block one element larger, which is taken from after the last used element when no hole fits, so
+ * that space has to hold the longest run growing by one element with each insert.
+ */
+bool map_element_can_insert(uint32 numInserts)
+{
+    uint64 needed = (uint64)numInserts * (_mapElementLongestRun + 1) + (uint64)numInserts * (numInserts - 1) / 2;
+    return needed <= map_element_get_tail_count();
+}
+
+/**
+ * Returns the number of elements that are free, either in holes or after the last used element.
+ */
+uint32 map_element_get_free_count()
+{
+    return _mapElementFreeListTotal + (uint32)((gMapElements + gMapElementsCapacity) - gNextFreeMapElement);
+}
+
+/**
+ * Takes the smallest hole of at least size elements off the free lists.
+ */
+static bool map_element_take_hole(uint32 size, map_element_free_block *block)
+{
+    for (uint32 i = size; i < MAP_ELEMENT_FREE_LIST_COUNT; i++) {
+        map_element_free_list *list = &_mapElementFreeLists[i];
+        while (list->count != 0) {
+            if (map_element_free_block_is_valid(list->blocks[list->count - 1])) {
+                *block = map_element_free_list_take(list, list->count - 1);
+                return true;
+            }
+            list->count--;
+        }
+    }
+
+    map_element_free_list *list = &_mapElementFreeLists[0];
+    for (size_t i = 0; i < list->count;) {
+        if (!map_element_free_block_is_valid(list->blocks[i])) {
+            map_element_free_list_remove(list, i);
+        } else if (list->blocks[i].size >= size) {
+            *block = map_element_free_list_take(list, i);
+            return true;
+        } else {
+            i++;
+        }
+    }
+    return false;
+}
+
+/**
+ * Allocates a block for a run of numElements elements, using the smallest hole it fits in or else the space after
+ * the last used element. Returns NULL if neither has room, which map_element_can_insert rules out.
+ */
+rct_map_element *map_element_allocate(sint32 numElements)
+{
+    uint32 size = (uint32)numElements;
+    _mapElementLongestRun = max(_mapElementLongestRun, size);
+
+    map_element_free_block block;
+    if (map_element_take_hole(size, &block)) {
+        if (block.size > size) {
+            map_element_free_list_push(block.start + size, block.size - size);
+        }
+        return gMapElements + block.start;
+    }
+
+    if (gNextFreeMapElement + size > gMapElements + gMapElementsCapacity) {
+        return NULL;
+    }
+    rct_map_element *mapElement = gNextFreeMapElement;
+    gNextFreeMapElement += size;
+    return mapElement;
+}
+
+/**
+ * Releases a block of elements that no tile uses anymore so it can be reused. The block is merged with the holes
+ * right before and after it, and given back to the space after the last used element if it ends there.
+ */
+void map_element_free(rct_map_element *mapElement, sint32 numElements)
+{
+    for (sint32 i = 0; i < numElements; i++) {
+        mapElement[i].base_height = 255;
+    }
+
+    uint32 start = (uint32)(mapElement - gMapElements);
+    uint32 size = (uint32)numElements;
+    if (map_element_hole_tags_available()) {
+        if (start > 0 && _mapElementHoleStarts[start - 1] != 0) {
+            uint32 holeStart = _mapElementHoleStarts[start - 1] - 1;
+            uint32 holeSize = _mapElementHoleSizes[holeStart];
+            map_element_hole_tags_set(holeStart, holeSize, 0, 0);
+            _mapElementFreeListTotal -= holeSize;
+            start = holeStart;
+            size += holeSize;
+        }
+
+        uint32 end = start + size;
+        if (end < gMapElementsCapacity && _mapElementHoleSizes[end] != 0) {
+            uint32 holeSize = _mapElementHoleSizes[end];
+            map_element_hole_tags_set(end, holeSize, 0, 0);
+            _mapElementFreeListTotal -= holeSize;
+            size += holeSize;
+        }
+    }
+
+    if (gMapElements + start + size == gNextFreeMapElement) {
+        gNextFreeMapElement = gMapElements + start;
+    } else {
+        map_element_free_list_push(start, size);
+    }
+}
+
+/**
+ * A separate element store with its own tile pointers and free lists. Swapping it in makes everything that works on
+ * the map use it instead of the map of the park, which is kept as it was in the store until swapped back.
+ */
+struct map_element_store {
+    rct_map_element *elements;
+    uint32 capacity;
+    rct_map_element *next_free;
+    rct_map_element **tile_pointers;
+    map_element_free_list free_lists[MAP_ELEMENT_FREE_LIST_COUNT];
+    uint32 free_list_total;
+    uint32 *hole_sizes;
+    uint32 *hole_starts;
+    uint32 hole_tags_capacity;
+    uint32 longest_run;
+    bool elements_allocated;
+};
+
+/**
+ * Creates an empty element store with room for the given number of elements. All its tiles are undefined, the elements
+ * have to be set up after swapping it in.
+ */
+map_element_store *map_element_store_create(uint32 capacity)
+{
+    map_element_store *store = calloc(1, sizeof(map_element_store));
+    if (store == NULL) {
+        return NULL;
+    }
+
+    store->elements = calloc(capacity, sizeof(rct_map_element));
+    store->tile_pointers = malloc(MAX_TILE_MAP_ELEMENT_POINTERS * sizeof(rct_map_element *));
+    if (store->elements == NULL || store->tile_pointers == NULL) {
+        log_error("Unable to allocate memory for map element store.");
+        free(store->elements);
+        free(store->tile_pointers);
+        free(store);
+        return NULL;
+    }
+    for (sint32 i = 0; i < MAX_TILE_MAP_ELEMENT_POINTERS; i++) {
+        store->tile_pointers[i] = TILE_UNDEFINED_MAP_ELEMENT;
+    }
+    store->capacity = capacity;
+    store->next_free = store->elements;
+    store->longest_run = 1;
+    store->elements_allocated = true;
+    return store;
+}
+
+/**
+ * Exchanges the element store in use with the given one, nothing is copied.
+ */
+void map_element_store_swap(map_element_store *store)
+{
+    viewport_pick_cache_invalidate();
+
+    map_element_store current;
+    current.elements = gMapElements;
+    current.capacity = gMapElementsCapacity;
+    current.next_free = gNextFreeMapElement;
+    current.tile_pointers = gMapElementTilePointers;
+    memcpy(current.free_lists, _mapElementFreeLists, sizeof(_mapElementFreeLists));
+    current.free_list_total = _mapElementFreeListTotal;
+    current.hole_sizes = _mapElementHoleSizes;
+    current.hole_starts = _mapElementHoleStarts;
+    current.hole_tags_capacity = _mapElementHoleTagsCapacity;
+    current.longest_run = _mapElementLongestRun;
+    current.elements_allocated = _mapElementsAllocated;
+
+    gMapElements = store->elements;
+    gMapElementsCapacity = store->capacity;
+    gNextFreeMapElement = store->next_free;
+    gMapElementTilePointers = store->tile_pointers;
+    memcpy(_mapElementFreeLists, store->free_lists, sizeof(_mapElementFreeLists));
+    _mapElementFreeListTotal = store->free_list_total;
+    _mapElementHoleSizes = store->hole_sizes;
+    _mapElementHoleStarts = store->hole_starts;
+    _mapElementHoleTagsCapacity = store->hole_tags_capacity;
+    _mapElementLongestRun = store->longest_run;
+    _mapElementsAllocated = store->elements_allocated;
+
+    *store = current;
+}
+
+/**
+ * Returns the number of elements the store has room for, which must not be swapped in.
+ */
+uint32 map_element_store_get_capacity(const map_element_store *store)
+{
+    return store->capacity;
+}
+
+/**
+ * Frees an element store created by map_element_store_create, which must not be swapped in.
+ */
+void map_element_store_free(map_element_store *store)
+{
+    if (store == NULL) {
+        return;
+    }
+    if (store->elements_allocated) {
+        free(store->elements);
+    }
+    free(store->tile_pointers);
+    free(store->hole_sizes);
+    free(store->hole_starts);
+    for (sint32 i = 0; i < MAP_ELEMENT_FREE_LIST_COUNT; i++) {
+        free(store->free_lists[i].blocks);
+    }
+    free(store);
+}
@@ -176,6 +176,7 @@ void reset_sprite_spatial_index()
             spr->unknown.next_in_quadrant = nextSpriteId;
         }
     }
+    sprite_spatial_index_rebuild();
 }
 
 static size_t GetSpatialIndexOffset(sint32 x, sint32 y)
@@ -198,31 +199,70 @@ static size_t GetSpatialIndexOffset(sint32 x, sint32 y)
 
 static uint8 _spriteChecksum[EVP_MAX_MD_SIZE + 1];
 
+/**
+ * Each sprite gets a cheap 64-bit hash and only those hashes go through SHA-1, rather than all of the sprite data.
+ * This is not incremental: every sprite is read and hashed again on each call, as sprites are written all over the
+ * game without going through one place that could mark them as changed. Null and misc sprites hash to 0.
+ */
+static uint64 _spriteHashes[MAX_SPRITES];
+
+static uint64 sprite_checksum_mix(uint64 hash, uint64 value)
+{
+    hash ^= value * 0x9E3779B97F4A7C15ULL;
+    hash = (hash << 31) | (hash >> 33);
+    return hash * 0xBF58476D1CE4E5B9ULL;
+}
+
+static uint64 sprite_checksum_finalise(uint64 hash)
+{
+    hash ^= hash >> 30;
+    hash *= 0xBF58476D1CE4E5B9ULL;
+    hash ^= hash >> 27;
+    hash *= 0x94D049BB133111EBULL;
+    return hash ^ (hash >> 31);
+}
+
+static uint64 sprite_checksum_sprite(const rct_sprite *sprite)
+{
+    if (sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_NULL || sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_MISC)
+    {
+        return 0;
+    }
+
+    rct_sprite copy = *sprite;
+    copy.unknown.sprite_left = copy.unknown.sprite_right = copy.unknown.sprite_top = copy.unknown.sprite_bottom = 0;
+
+    if (copy.unknown.sprite_identifier == SPRITE_IDENTIFIER_PEEP) {
+        // We set this to 0 because as soon the client selects a guest the window will remove the
+        // invalidation flags causing the sprite checksum to be different than on server, the flag does not affect game state.
+        copy.peep.window_invalidate_flags = 0;
+    }
+
+    uint64 words[sizeof(rct_sprite) / sizeof(uint64)];
+    memcpy(words, &copy, sizeof(words));
+
+    uint64 hash = sizeof(rct_sprite);
+    for (size_t i = 0; i < countof(words); i++)
+    {
+        hash = sprite_checksum_mix(hash, words[i]);
+    }
+    return sprite_checksum_finalise(hash);
+}
+
 const char * sprite_checksum()
 {
+    for (size_t i = 0; i < MAX_SPRITES; i++)
+    {
+        _spriteHashes[i] = sprite_checksum_sprite(get_sprite(i));
+    }
+
     if (EVP_DigestInit_ex(gHashCTX, EVP_sha1(), NULL) <= 0)
     {
         openrct2_assert(false, "Failed to initialise SHA1 engine");
     }
-    for (size_t i = 0; i < MAX_SPRITES; i++)
+    if (EVP_DigestUpdate(gHashCTX, _spriteHashes, sizeof(_spriteHashes)) <= 0)
     {
-        rct_sprite *sprite = get_sprite(i);
-        if (sprite->unknown.sprite_identifier != SPRITE_IDENTIFIER_NULL && sprite->unknown.sprite_identifier != SPRITE_IDENTIFIER_MISC)
-        {
-            rct_sprite copy = *sprite;
-            copy.unknown.sprite_left = copy.unknown.sprite_right = copy.unknown.sprite_top = copy.unknown.sprite_bottom = 0;
-
-            if (copy.unknown.sprite_identifier == SPRITE_IDENTIFIER_PEEP) {
-                // We set this to 0 because as soon the client selects a guest the window will remove the
-                // invalidation flags causing the sprite checksum to be different than on server, the flag does not affect game state.
-                copy.peep.window_invalidate_flags = 0;
-            }
-
-            if (EVP_DigestUpdate(gHashCTX, &copy, sizeof(rct_sprite)) <= 0)
-            {
-                openrct2_assert(false, "Failed to update digest");
-            }
-        }
+        openrct2_assert(false, "Failed to update digest");
     }
     uint8 localhash[EVP_MAX_MD_SIZE + 1];
     uint32 size = sizeof(localhash);
@@ -332,8 +372,7 @@ rct_sprite *create_sprite(uint8 bl)
     sprite->flags = 0;
     sprite->sprite_left = SPRITE_LOCATION_NULL;
 
-    sprite->next_in_quadrant = gSpriteSpatialIndex[SPATIAL_INDEX_LOCATION_NULL];
-    gSpriteSpatialIndex[SPATIAL_INDEX_LOCATION_NULL] = sprite->sprite_index;
+    sprite_spatial_index_link((rct_sprite*)sprite, SPATIAL_INDEX_LOCATION_NULL);
 
     return (rct_sprite*)sprite;
 }
@@ -387,6 +426,8 @@ void move_sprite_to_list(rct_sprite *sprite, uint8 newListOffset)
     // Decrement old list counter, increment new list counter.
     gSpriteListCount[oldList]--;
     gSpriteListCount[newList]++;
+
+    sprite_spatial_index_set_list(sprite, newList);
 }
 
 /**
@@ -547,22 +588,8 @@ void sprite_move(sint16 x, sint16 y, sint16 z, rct_sprite *sprite)
     size_t newIndex = GetSpatialIndexOffset(x, y);
     size_t currentIndex = GetSpatialIndexOffset(sprite->unknown.x, sprite->unknown.y);
     if (newIndex != currentIndex) {
-        uint16 *spriteIndex = &gSpriteSpatialIndex[currentIndex];
-        if (*spriteIndex != SPRITE_INDEX_NULL) {
-            rct_sprite *sprite2 = get_sprite(*spriteIndex);
-            while (sprite != sprite2) {
-                spriteIndex = &sprite2->unknown.next_in_quadrant;
-                if (*spriteIndex == SPRITE_INDEX_NULL) {
-                    break;
-                }
-                sprite2 = get_sprite(*spriteIndex);
-            }
-        }
-        *spriteIndex = sprite->unknown.next_in_quadrant;
-
-        sint32 tempSpriteIndex = gSpriteSpatialIndex[newIndex];
-        gSpriteSpatialIndex[newIndex] = sprite->unknown.sprite_index;
-        sprite->unknown.next_in_quadrant = tempSpriteIndex;
+        sprite_spatial_index_unlink(sprite, currentIndex);
+        sprite_spatial_index_link(sprite, newIndex);
     }
 
     if (x == SPRITE_LOCATION_NULL) {
@@ -611,18 +638,13 @@ void sprite_set_coordinates(sint16 x, sint16 y, sint16 z, rct_sprite *sprite){
  */
 void sprite_remove(rct_sprite *sprite)
 {
+    size_t quadrantIndex = GetSpatialIndexOffset(sprite->unknown.x, sprite->unknown.y);
+    sprite_spatial_index_unlink(sprite, quadrantIndex);
+
     move_sprite_to_list(sprite, SPRITE_LIST_NULL * 2);
     user_string_free(sprite->unknown.name_string_idx);
     sprite->unknown.sprite_identifier = SPRITE_IDENTIFIER_NULL;
     _spriteFlashingList[sprite->unknown.sprite_index] = false;
-
-    size_t quadrantIndex = GetSpatialIndexOffset(sprite->unknown.x, sprite->unknown.y);
-    uint16 *spriteIndex = &gSpriteSpatialIndex[quadrantIndex];
-    rct_sprite *quadrantSprite;
-    while ((quadrantSprite = get_sprite(*spriteIndex)) != sprite) {
-        spriteIndex = &quadrantSprite->unknown.next_in_quadrant;
-    }
-    *spriteIndex = sprite->unknown.next_in_quadrant;
 }
 
 static bool litter_can_be_at(sint32 x, sint32 y, sint32 z)
@@ -704,21 +726,19 @@ void litter_create(sint32 x, sint32 y, sint32 z, sint32 direction, sint32 type)
  */
 void litter_remove_at(sint32 x, sint32 y, sint32 z)
 {
-    uint16 spriteIndex = sprite_get_first_in_quadrant(x, y);
-    while (spriteIndex != SPRITE_INDEX_NULL) {
-        rct_sprite *sprite = get_sprite(spriteIndex);
-        uint16 nextSpriteIndex = sprite->unknown.next_in_quadrant;
-        if (sprite->unknown.linked_list_type_offset == SPRITE_LIST_LITTER * 2) {
-            rct_litter *litter = &sprite->litter;
-
-            if (abs(litter->z - z) <= 16) {
-                if (abs(litter->x - x) <= 8 && abs(litter->y - y) <= 8) {
-                    invalidate_sprite_0(sprite);
-                    sprite_remove(sprite);
-                }
+    sprite_spatial_query query;
+    rct_sprite *sprite;
+
+    sprite_spatial_query_begin_tile(&query, x, y, SPRITE_LIST_LITTER);
+    while ((sprite = sprite_spatial_query_next(&query)) != NULL) {
+        rct_litter *litter = &sprite->litter;
+
+        if (abs(litter->z - z) <= 16) {
+            if (abs(litter->x - x) <= 8 && abs(litter->y - y) <= 8) {
+                invalidate_sprite_0(sprite);
+                sprite_remove(sprite);
             }
         }
-        spriteIndex = nextSpriteIndex;
     }
 }
 
@@ -1027,6 +1047,7 @@ sint32 check_for_spatial_index_cycles(bool fix)
                     spr->unknown.next_in_quadrant = SPRITE_INDEX_NULL;
                     cycle_start = spr;
                 }
+                sprite_spatial_index_rebuild();
             }
             return i;
         }
@@ -422,6 +422,26 @@ extern uint16 *gSpriteListCount;
 
 extern uint16 gSpriteSpatialIndex[0x10001];
 
+typedef struct sprite_spatial_query {
+    sint32 list;
+    sint32 left;
+    sint32 top;
+    sint32 right;
+    sint32 bottom;
+    sint32 tile_x;
+    sint32 tile_y;
+    uint16 next;
+} sprite_spatial_query;
+
+void sprite_spatial_index_rebuild();
+void sprite_spatial_index_link(rct_sprite *sprite, size_t index);
+void sprite_spatial_index_unlink(rct_sprite *sprite, size_t index);
+void sprite_spatial_index_set_list(rct_sprite *sprite, sint32 newList);
+void sprite_spatial_query_begin(sprite_spatial_query *query, sint32 left, sint32 top, sint32 right, sint32 bottom, sint32 list);
+void sprite_spatial_query_begin_around(sprite_spatial_query *query, sint32 x, sint32 y, sint32 distance, sint32 list);
+void sprite_spatial_query_begin_tile(sprite_spatial_query *query, sint32 x, sint32 y, sint32 list);
+rct_sprite *sprite_spatial_query_next(sprite_spatial_query *query);
+
 rct_sprite *create_sprite(uint8 bl);
 void reset_sprite_list();
 void reset_sprite_spatial_index();
@@ -0,0 +1,258 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include "sprite.h"
+
+/**
+ * Buckets of the sprites on each tile, one chain per sprite list, kept next to the chains of gSpriteSpatialIndex.
+ * Queries for the peeps, vehicles or litter near a location only visit sprites of that list instead of every
+ * sprite on the tiles. The sprites of a bucket are always in the same order as in the tile's chain, so a query
+ * visits the same sprites in the same order as walking the chain and skipping the other lists.
+ *
+ * The previous sprite of each sprite in the tile's chain is kept as well, so moving a sprite to another tile no
+ * longer walks the chain to unlink it. gSpriteSpatialIndex and next_in_quadrant stay the authority, they are saved
+ * and sent to clients, and everything here is rebuilt from them whenever they are replaced.
+ */
+
+#define SPATIAL_INDEX_SIZE 0x10001
+#define SPATIAL_LIST_NONE 0xFF
+
+static uint16 _spatialListHeads[NUM_SPRITE_LISTS][SPATIAL_INDEX_SIZE];
+static uint16 _spatialListNext[MAX_SPRITES];
+static uint16 _spatialListPrevious[MAX_SPRITES];
+static uint16 _spatialPrevious[MAX_SPRITES];
+static uint32 _spatialIndex[MAX_SPRITES];
+static uint8 _spatialList[MAX_SPRITES];
+
+static void sprite_spatial_list_insert(uint16 spriteIndex, sint32 list, uint32 index, uint16 previousIndex)
+{
+    uint16 *next = previousIndex == SPRITE_INDEX_NULL ?
+        &_spatialListHeads[list][index] :
+        &_spatialListNext[previousIndex];
+
+    _spatialListPrevious[spriteIndex] = previousIndex;
+    _spatialListNext[spriteIndex] = *next;
+    if (*next != SPRITE_INDEX_NULL) {
+        _spatialListPrevious[*next] = spriteIndex;
+    }
+    *next = spriteIndex;
+    _spatialList[spriteIndex] = (uint8)list;
+    _spatialIndex[spriteIndex] = index;
+}
+
+static void sprite_spatial_list_remove(uint16 spriteIndex)
+{
+    uint8 list = _spatialList[spriteIndex];
+    if (list == SPATIAL_LIST_NONE) {
+        return;
+    }
+
+    uint16 previousIndex = _spatialListPrevious[spriteIndex];
+    uint16 nextIndex = _spatialListNext[spriteIndex];
+    if (previousIndex == SPRITE_INDEX_NULL) {
+        _spatialListHeads[list][_spatialIndex[spriteIndex]] = nextIndex;
+    } else {
+        _spatialListNext[previousIndex] = nextIndex;
+    }
+    if (nextIndex != SPRITE_INDEX_NULL) {
+        _spatialListPrevious[nextIndex] = previousIndex;
+    }
+    _spatialList[spriteIndex] = SPATIAL_LIST_NONE;
+}
+
+/**
+ * Rebuilds the buckets and previous links from gSpriteSpatialIndex, must be called whenever it or the
+ * next_in_quadrant of the sprites have been replaced or repaired.
+ */
+void sprite_spatial_index_rebuild()
+{
+    memset(_spatialListHeads, 0xFF, sizeof(_spatialListHeads));
+    memset(_spatialList, SPATIAL_LIST_NONE, sizeof(_spatialList));
+
+    for (uint32 index = 0; index < SPATIAL_INDEX_SIZE; index++) {
+        uint16 tails[NUM_SPRITE_LISTS];
+        memset(tails, 0xFF, sizeof(tails));
+
+        uint16 previousIndex = SPRITE_INDEX_NULL;
+        uint16 spriteIndex = gSpriteSpatialIndex[index];
+        for (sint32 count = 0; spriteIndex < MAX_SPRITES && count < MAX_SPRITES; count++) {
+            rct_sprite *sprite = get_sprite(spriteIndex);
+            sint32 list = sprite->unknown.linked_list_type_offset >> 1;
+            if (list >= NUM_SPRITE_LISTS) {
+                list = SPRITE_LIST_NULL;
+            }
+
+            _spatialPrevious[spriteIndex] = previousIndex;
+            sprite_spatial_list_insert(spriteIndex, list, index, tails[list]);
+            tails[list] = spriteIndex;
+
+            previousIndex = spriteIndex;
+            spriteIndex = sprite->unknown.next_in_quadrant;
+        }
+    }
+}
+
+/**
+ * Links a sprite in as the first sprite of the given index of gSpriteSpatialIndex.
+ */
+void sprite_spatial_index_link(rct_sprite *sprite, size_t index)
+{
+    uint16 spriteIndex = sprite->unknown.sprite_index;
+    uint16 headIndex = gSpriteSpatialIndex[index];
+
+    sprite->unknown.next_in_quadrant = headIndex;
+    if (headIndex < MAX_SPRITES) {
+        _spatialPrevious[headIndex] = spriteIndex;
+    }
+    _spatialPrevious[spriteIndex] = SPRITE_INDEX_NULL;
+    gSpriteSpatialIndex[index] = spriteIndex;
+
+    sprite_spatial_list_remove(spriteIndex);
+    sint32 list = sprite->unknown.linked_list_type_offset >> 1;
+    if (list < NUM_SPRITE_LISTS) {
+        sprite_spatial_list_insert(spriteIndex, list, (uint32)index, SPRITE_INDEX_NULL);
+    }
+}
+
+/**
+ * Unlinks a sprite from the given index of gSpriteSpatialIndex. next_in_quadrant of the sprite is left as it was.
+ */
+void sprite_spatial_index_unlink(rct_sprite *sprite, size_t index)
+{
+    uint16 spriteIndex = sprite->unknown.sprite_index;
+    uint16 nextIndex = sprite->unknown.next_in_quadrant;
+    uint16 previousIndex = _spatialPrevious[spriteIndex];
+
+    uint16 *link;
+    if (previousIndex == SPRITE_INDEX_NULL) {
+        link = &gSpriteSpatialIndex[index];
+    } else {
+        link = &get_sprite(previousIndex)->unknown.next_in_quadrant;
+    }
+
+    if (*link != spriteIndex) {
+        // Only when the previous links are out of date, find the link by walking the chain like RCT2 did
+        link = &gSpriteSpatialIndex[index];
+        previousIndex = SPRITE_INDEX_NULL;
+        while (*link != SPRITE_INDEX_NULL && *link != spriteIndex) {
+            previousIndex = *link;
+            link = &get_sprite(previousIndex)->unknown.next_in_quadrant;
+        }
+    }
+
+    *link = nextIndex;
+    if (nextIndex < MAX_SPRITES) {
+        _spatialPrevious[nextIndex] = previousIndex;
+    }
+    sprite_spatial_list_remove(spriteIndex);
+}
+
+/**
+ * Moves a sprite that move_sprite_to_list has moved to another list to the bucket of that list, keeping the order of
+ * the bucket the same as the order of the tile's chain.
+ */
+void sprite_spatial_index_set_list(rct_sprite *sprite, sint32 newList)
+{
+    uint16 spriteIndex = sprite->unknown.sprite_index;
+    uint8 list = _spatialList[spriteIndex];
+    if (list == SPATIAL_LIST_NONE || list == newList || newList >= NUM_SPRITE_LISTS) {
+        return;
+    }
+
+    uint32 index = _spatialIndex[spriteIndex];
+    sprite_spatial_list_remove(spriteIndex);
+
+    // The sprite goes after the last sprite of the new list that comes before it in the tile's chain
+    uint16 previousIndex = SPRITE_INDEX_NULL;
+    uint16 otherIndex = gSpriteSpatialIndex[index];
+    for (sint32 count = 0; otherIndex < MAX_SPRITES && otherIndex != spriteIndex && count < MAX_SPRITES; count++) {
+        if (_spatialList[otherIndex] == newList) {
+            previousIndex = otherIndex;
+        }
+        otherIndex = get_sprite(otherIndex)->unknown.next_in_quadrant;
+    }
+    sprite_spatial_list_insert(spriteIndex, newList, index, previousIndex);
+}
+
+/**
+ * Starts a query for the sprites of the given list on all tiles that overlap the given rectangle in map coordinates.
+ * Tiles are visited column by column. A list of -1 visits the sprites of all lists.
+ */
+void sprite_spatial_query_begin(sprite_spatial_query *query, sint32 left, sint32 top, sint32 right, sint32 bottom, sint32 list)
+{
+    query->list = list;
+    query->left = clamp(0, left >> 5, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    query->top = clamp(0, top >> 5, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    query->right = clamp(0, right >> 5, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    query->bottom = clamp(0, bottom >> 5, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    query->tile_x = query->left;
+    query->tile_y = query->top - 1;
+    query->next = SPRITE_INDEX_NULL;
+    if (left > right || top > bottom) {
+        // Nothing to visit, start at the last tile as if it had been visited already
+        query->tile_x = query->right;
+        query->tile_y = query->bottom;
+    }
+}
+
+/**
+ * Starts a query for the sprites of the given list on the tiles within the given distance of a location.
+ */
+void sprite_spatial_query_begin_around(sprite_spatial_query *query, sint32 x, sint32 y, sint32 distance, sint32 list)
+{
+    sprite_spatial_query_begin(query, x - distance, y - distance, x + distance, y + distance, list);
+}
+
+/**
+ * Starts a query for the sprites of the given list on the tile of a location.
+ */
+void sprite_spatial_query_begin_tile(sprite_spatial_query *query, sint32 x, sint32 y, sint32 list)
+{
+    sprite_spatial_query_begin(query, x, y, x, y, list);
+}
+
+/**
+ * Returns the next sprite of the query, or NULL when there are no more. The sprite after the returned one is found
+ * beforehand, so the returned sprite may be removed or moved.
+ */
+rct_sprite *sprite_spatial_query_next(sprite_spatial_query *query)
+{
+    while (query->next == SPRITE_INDEX_NULL) {
+        if (query->tile_y < query->bottom) {
+            query->tile_y++;
+        } else if (query->tile_x < query->right) {
+            query->tile_x++;
+            query->tile_y = query->top;
+        } else {
+            return NULL;
+        }
+
+        uint32 index = ((uint32)query->tile_x << 8) | (uint32)query->tile_y;
+        if (query->list < 0) {
+            query->next = gSpriteSpatialIndex[index];
+        } else {
+            query->next = _spatialListHeads[query->list][index];
+        }
+    }
+
+    rct_sprite *sprite = get_sprite(query->next);
+    if (query->list < 0) {
+        query->next = sprite->unknown.next_in_quadrant;
+    } else {
+        query->next = _spatialListNext[query->next];
+    }
+    return sprite;
+}
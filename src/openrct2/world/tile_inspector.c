@@ -42,7 +42,8 @@ static bool map_swap_elements_at(sint32 x, sint32 y, sint16 first, sint16 second
         return false;
     }
 
-    // Swap their memory
+    // Swap their memory, the kept hits of the pixels would point at the other element
+    viewport_pick_cache_invalidate();
     rct_map_element temp = *firstElement;
     *firstElement = *secondElement;
     *secondElement = temp;
@@ -268,6 +269,10 @@ sint32 tile_inspector_paste_element_at(sint32 x, sint32 y, rct_map_element eleme
         {
             pastedElement->flags |= MAP_ELEMENT_FLAG_LAST_TILE;
         }
+        if (map_element_get_type(pastedElement) == MAP_ELEMENT_TYPE_TRACK)
+        {
+            ride_tile_index_add(x, y, pastedElement->properties.track.ride_index);
+        }
 
         map_invalidate_tile_full(x << 5, y << 5);
 
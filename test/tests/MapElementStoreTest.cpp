@@ -0,0 +1,186 @@
+#include <cstring>
+#include <vector>
+#include <gtest/gtest.h>
+#include <openrct2/world/map.h>
+
+/**
+ * Game commands hold on to element pointers while they insert elements, so inserting must never move the element
+ * store to a new allocation nor move the elements of other tiles. The store is only grown, or its last runs moved,
+ * by map_element_reserve_margin, between ticks.
+ */
+class MapElementStoreTest : public testing::Test
+{
+protected:
+    static constexpr sint32 FillerSize = 32;
+
+    void SetUp() override
+    {
+        // A surface element on each tile, like map_init but without the park and windows around it
+        for (sint32 i = 0; i < MAX_TILE_MAP_ELEMENT_POINTERS; i++)
+        {
+            rct_map_element * mapElement = &gMapElements[i];
+            std::memset(mapElement, 0, sizeof(rct_map_element));
+            mapElement->type = MAP_ELEMENT_TYPE_SURFACE;
+            mapElement->flags = MAP_ELEMENT_FLAG_LAST_TILE;
+            mapElement->base_height = 14;
+            mapElement->clearance_height = 14;
+        }
+        map_update_tile_pointers();
+    }
+
+    static uint32 GetTailCount()
+    {
+        return (uint32)((gMapElements + gMapElementsCapacity) - gNextFreeMapElement);
+    }
+
+    static void InsertElements(sint32 x, sint32 y, sint32 count)
+    {
+        for (sint32 i = 0; i < count; i++)
+        {
+            ASSERT_NE(map_element_insert(x, y, 20 + i, 0), nullptr);
+        }
+    }
+
+    static sint32 CountElements(sint32 x, sint32 y)
+    {
+        sint32 count = 0;
+        rct_map_element * mapElement = map_get_first_element_at(x, y);
+        do
+        {
+            EXPECT_NE(mapElement->base_height, 255);
+            count++;
+        }
+        while (!map_element_is_last_for_tile(mapElement++));
+        return count;
+    }
+
+    /**
+     * Fills the store with blocks that no tile uses and then with the runs of tiles in row 1, until an insert finds
+     * no room, and frees every other block. Many elements are free afterwards, but in holes of FillerSize elements.
+     */
+    static void Fragment()
+    {
+        std::vector<rct_map_element *> fillers;
+        while (GetTailCount() > 2048 + FillerSize)
+        {
+            fillers.push_back(map_element_allocate(FillerSize));
+        }
+        for (sint32 i = 0; ; i++)
+        {
+            if (map_element_insert((i % 128) * 2, 1, 20 + (i / 128) % 100, 0) == nullptr)
+            {
+                break;
+            }
+        }
+        for (size_t i = 0; i < fillers.size(); i += 2)
+        {
+            map_element_free(fillers[i], FillerSize);
+        }
+    }
+
+    /**
+     * Tile (50, 50) gets more elements than fit in a hole of the fragmented store, so inserting on it has to use the
+     * space after the last used element. Tile (200, 200) comes after it, a compaction of the store would move it.
+     */
+    static void CheckFragmentedInsert()
+    {
+        InsertElements(50, 50, 39);
+        rct_map_element * heldElement = map_get_first_element_at(200, 200);
+        rct_map_element heldCopy = *heldElement;
+        rct_map_element * mapElements = gMapElements;
+        uint32 capacity = gMapElementsCapacity;
+
+        Fragment();
+        EXPECT_GT(map_element_get_free_count(), (uint32)(FillerSize * 1000));
+        EXPECT_FALSE(map_check_free_elements_and_reorganise(1));
+
+        // Without room after the last used element the insert fails, nothing else is moved to make room
+        EXPECT_EQ(map_element_insert(50, 50, 120, 0), nullptr);
+        EXPECT_EQ(gMapElements, mapElements);
+        EXPECT_EQ(gMapElementsCapacity, capacity);
+        EXPECT_EQ(map_get_first_element_at(200, 200), heldElement);
+        EXPECT_EQ(std::memcmp(heldElement, &heldCopy, sizeof(rct_map_element)), 0);
+
+        // Smaller runs still fit in the holes
+        EXPECT_NE(map_element_insert(3, 3, 120, 0), nullptr);
+        EXPECT_EQ(map_get_first_element_at(200, 200), heldElement);
+        EXPECT_EQ(std::memcmp(heldElement, &heldCopy, sizeof(rct_map_element)), 0);
+
+        // Between ticks there is room made for the insert
+        map_element_reserve_margin();
+        EXPECT_TRUE(map_check_free_elements_and_reorganise(1));
+        EXPECT_NE(map_element_insert(50, 50, 120, 0), nullptr);
+        EXPECT_EQ(CountElements(50, 50), 41);
+        EXPECT_EQ(CountElements(3, 3), 2);
+        EXPECT_EQ(std::memcmp(map_get_first_element_at(200, 200), &heldCopy, sizeof(rct_map_element)), 0);
+        for (sint32 x = 0; x < 256; x += 2)
+        {
+            CountElements(x, 1);
+        }
+    }
+};
+
+TEST_F(MapElementStoreTest, fragmented_insert_keeps_element_pointers)
+{
+    ASSERT_LT(gMapElementsCapacity, (uint32)MAX_MAP_ELEMENTS_EXTENDED);
+    uint32 capacity = gMapElementsCapacity;
+    CheckFragmentedInsert();
+
+    // The store is grown between ticks
+    EXPECT_GT(gMapElementsCapacity, capacity);
+}
+
+TEST_F(MapElementStoreTest, fragmented_insert_at_cap_keeps_element_pointers)
+{
+    ASSERT_TRUE(map_element_reserve(MAX_MAP_ELEMENTS_EXTENDED));
+    ASSERT_EQ(gMapElementsCapacity, (uint32)MAX_MAP_ELEMENTS_EXTENDED);
+    rct_map_element * mapElements = gMapElements;
+    CheckFragmentedInsert();
+
+    // The store can not grow any further, so the last runs were moved into holes instead
+    EXPECT_EQ(gMapElements, mapElements);
+    EXPECT_EQ(gMapElementsCapacity, (uint32)MAX_MAP_ELEMENTS_EXTENDED);
+}
+
+TEST_F(MapElementStoreTest, free_merges_neighbouring_holes)
+{
+    uint32 freeCount = map_element_get_free_count();
+    rct_map_element * before = map_element_allocate(3);
+    rct_map_element * middle = map_element_allocate(2);
+    rct_map_element * after = map_element_allocate(4);
+    rct_map_element * last = map_element_allocate(1);
+    ASSERT_NE(last, nullptr);
+    ASSERT_EQ(middle, before + 3);
+    ASSERT_EQ(after, middle + 2);
+
+    // The holes on either side of the middle block become one hole with it
+    map_element_free(before, 3);
+    map_element_free(after, 4);
+    map_element_free(middle, 2);
+    EXPECT_EQ(map_element_get_free_count(), freeCount - 1);
+    EXPECT_EQ(map_element_allocate(9), before);
+    EXPECT_EQ(map_element_get_free_count(), freeCount - 10);
+
+    // The entries of the holes that were merged away are not handed out again
+    map_element_free(before, 9);
+    EXPECT_EQ(map_element_allocate(3), before);
+    EXPECT_EQ(map_element_allocate(4), before + 3);
+    EXPECT_EQ(map_element_allocate(2), before + 7);
+    EXPECT_EQ(map_element_get_free_count(), freeCount - 10);
+}
+
+TEST_F(MapElementStoreTest, free_at_end_gives_back_trailing_holes)
+{
+    uint32 freeCount = map_element_get_free_count();
+    rct_map_element * nextFree = gNextFreeMapElement;
+    rct_map_element * first = map_element_allocate(2);
+    rct_map_element * second = map_element_allocate(5);
+    ASSERT_EQ(first, nextFree);
+
+    map_element_free(first, 2);
+    EXPECT_EQ(gNextFreeMapElement, nextFree + 7);
+
+    map_element_free(second, 5);
+    EXPECT_EQ(gNextFreeMapElement, nextFree);
+    EXPECT_EQ(map_element_get_free_count(), freeCount);
+}
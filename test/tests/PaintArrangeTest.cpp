@@ -0,0 +1,197 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <vector>
+#include <openrct2/interface/viewport.h>
+#include <openrct2/paint/paint.h>
+
+/**
+ * Checks that paint_session_arrange gives the draw order of the quadrant pass as it was written for an array: for each
+ * quadrant, any paint struct of the next quadrant that the bounding box of one of this quadrant's paint structs says
+ * has to be drawn first is moved in front of it.
+ */
+class PaintArrangeTest : public testing::Test
+{
+protected:
+    std::mt19937 _random { 1 };
+    std::unique_ptr<paint_session> _session;
+    std::vector<paint_struct> _paintStructs;
+
+    void SetUp() override
+    {
+        _session = std::make_unique<paint_session>();
+    }
+
+    static bool IsDrawnBefore(uint8 rotation, const paint_struct * initial, const paint_struct * current)
+    {
+        bool zOverlap = initial->bound_box_z_end >= current->bound_box_z;
+        bool zBehind = initial->bound_box_z < current->bound_box_z_end;
+        switch (rotation)
+        {
+        case 0:
+            return zOverlap && initial->bound_box_y_end >= current->bound_box_y && initial->bound_box_x_end >= current->bound_box_x
+                && !(zBehind && initial->bound_box_y < current->bound_box_y_end && initial->bound_box_x < current->bound_box_x_end);
+        case 1:
+            return zOverlap && initial->bound_box_y_end >= current->bound_box_y && initial->bound_box_x_end < current->bound_box_x
+                && !(zBehind && initial->bound_box_y < current->bound_box_y_end && initial->bound_box_x >= current->bound_box_x_end);
+        case 2:
+            return zOverlap && initial->bound_box_y_end < current->bound_box_y && initial->bound_box_x_end < current->bound_box_x
+                && !(zBehind && initial->bound_box_y >= current->bound_box_y_end && initial->bound_box_x >= current->bound_box_x_end);
+        default:
+            return zOverlap && initial->bound_box_y_end < current->bound_box_y && initial->bound_box_x_end >= current->bound_box_x
+                && !(zBehind && initial->bound_box_y >= current->bound_box_y_end && initial->bound_box_x < current->bound_box_x_end);
+        }
+    }
+
+    /**
+     * The pass over a flat array, where a paint struct is moved ahead by shifting those in between.
+     */
+    static size_t ArrangeQuadrant(std::vector<paint_struct *> &order, size_t start, uint16 quadrantIndex, uint8 flag, uint8 rotation)
+    {
+        size_t position = start;
+        while (true)
+        {
+            if (position + 1 >= order.size()) return position;
+            if (quadrantIndex <= order[position + 1]->quadrant_index) break;
+            position++;
+        }
+        size_t cachePosition = position;
+
+        for (size_t i = position + 1; i < order.size(); i++)
+        {
+            paint_struct * ps = order[i];
+            if (ps->quadrant_index > quadrantIndex + 1)
+            {
+                ps->quadrant_flags = PAINT_QUADRANT_FLAG_BIGGER;
+                break;
+            }
+            else if (ps->quadrant_index == quadrantIndex + 1)
+            {
+                ps->quadrant_flags = PAINT_QUADRANT_FLAG_NEXT | PAINT_QUADRANT_FLAG_IDENTICAL;
+            }
+            else if (ps->quadrant_index == quadrantIndex)
+            {
+                ps->quadrant_flags = flag | PAINT_QUADRANT_FLAG_IDENTICAL;
+            }
+        }
+
+        while (true)
+        {
+            size_t initialPosition;
+            while (true)
+            {
+                initialPosition = position + 1;
+                if (initialPosition >= order.size()) return cachePosition;
+                uint8 quadrantFlags = order[initialPosition]->quadrant_flags;
+                if (quadrantFlags & PAINT_QUADRANT_FLAG_BIGGER) return cachePosition;
+                if (quadrantFlags & PAINT_QUADRANT_FLAG_IDENTICAL) break;
+                position = initialPosition;
+            }
+
+            paint_struct * initial = order[initialPosition];
+            initial->quadrant_flags &= ~PAINT_QUADRANT_FLAG_IDENTICAL;
+            for (size_t i = initialPosition + 1; i < order.size(); i++)
+            {
+                paint_struct * ps = order[i];
+                if (ps->quadrant_flags & PAINT_QUADRANT_FLAG_BIGGER) break;
+                if (!(ps->quadrant_flags & PAINT_QUADRANT_FLAG_NEXT)) continue;
+                if (IsDrawnBefore(rotation, initial, ps))
+                {
+                    order.erase(order.begin() + i);
+                    order.insert(order.begin() + position + 1, ps);
+                }
+            }
+        }
+    }
+
+    /**
+     * Paint structs with random bounding boxes in a few neighbouring tiles, so many of them overlap, added to random
+     * quadrants the way paint_session_add_ps_to_quadrant does.
+     */
+    void MakeScene(size_t count, uint32 numQuadrants)
+    {
+        _paintStructs.assign(count, paint_struct());
+        for (sint32 i = 0; i < MAX_PAINT_QUADRANTS; i++)
+        {
+            _session->Quadrants[i] = nullptr;
+        }
+        uint32 backIndex = 100 + _random() % 100;
+        _session->QuadrantBackIndex = backIndex;
+        _session->QuadrantFrontIndex = backIndex + numQuadrants - 1;
+        for (auto &ps : _paintStructs)
+        {
+            ps.bound_box_x = (uint16)(_random() % 96);
+            ps.bound_box_y = (uint16)(_random() % 96);
+            ps.bound_box_z = (uint16)(_random() % 64);
+            ps.bound_box_x_end = ps.bound_box_x + (uint16)(_random() % 32);
+            ps.bound_box_y_end = ps.bound_box_y + (uint16)(_random() % 32);
+            ps.bound_box_z_end = ps.bound_box_z + (uint16)(_random() % 32);
+            ps.quadrant_index = (uint16)(backIndex + _random() % numQuadrants);
+            ps.next_quadrant_ps = _session->Quadrants[ps.quadrant_index];
+            _session->Quadrants[ps.quadrant_index] = &ps;
+        }
+    }
+
+    std::vector<paint_struct *> GetExpectedOrder(uint8 rotation)
+    {
+        paint_struct head = {};
+        std::vector<paint_struct *> order = { &head };
+        for (uint32 i = _session->QuadrantBackIndex; i <= _session->QuadrantFrontIndex; i++)
+        {
+            for (paint_struct * ps = _session->Quadrants[i]; ps != nullptr; ps = ps->next_quadrant_ps)
+            {
+                order.push_back(ps);
+            }
+        }
+
+        size_t cachePosition = ArrangeQuadrant(order, 0, _session->QuadrantBackIndex & 0xFFFF, PAINT_QUADRANT_FLAG_NEXT, rotation);
+        for (uint32 i = _session->QuadrantBackIndex + 1; i < _session->QuadrantFrontIndex; i++)
+        {
+            cachePosition = ArrangeQuadrant(order, cachePosition, i & 0xFFFF, 0, rotation);
+        }
+        order.erase(order.begin());
+        return order;
+    }
+
+    std::vector<paint_struct *> GetArrangedOrder()
+    {
+        std::vector<paint_struct *> order;
+        paint_struct head = paint_session_arrange(_session.get());
+        for (paint_struct * ps = head.next_quadrant_ps; ps != nullptr; ps = ps->next_quadrant_ps)
+        {
+            order.push_back(ps);
+        }
+        return order;
+    }
+};
+
+TEST_F(PaintArrangeTest, arranges_in_order_of_array_pass)
+{
+    for (uint8 rotation = 0; rotation < 4; rotation++)
+    {
+        gCurrentRotation = rotation;
+        for (sint32 scene = 0; scene < 50; scene++)
+        {
+            MakeScene(1 + _random() % 400, 1 + _random() % 12);
+
+            // Both passes change the flags of the paint structs, so the scene is arranged from a copy of them
+            std::vector<paint_struct> original = _paintStructs;
+            auto expected = GetExpectedOrder(rotation);
+            for (size_t i = 0; i < _paintStructs.size(); i++)
+            {
+                _paintStructs[i].quadrant_flags = original[i].quadrant_flags;
+                _paintStructs[i].next_quadrant_ps = original[i].next_quadrant_ps;
+            }
+            auto actual = GetArrangedOrder();
+            ASSERT_EQ(expected, actual) << "rotation " << (sint32)rotation << ", scene " << scene;
+        }
+    }
+}
+
+TEST_F(PaintArrangeTest, empty_session_arranges_nothing)
+{
+    _session->QuadrantBackIndex = UINT32_MAX;
+    paint_struct head = paint_session_arrange(_session.get());
+    EXPECT_EQ(head.next_quadrant_ps, nullptr);
+}
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include <openrct2/drawing/SpriteBlit.h>
+
+/**
+ * Checks the line kernels against drawing the pixels one at a time the way the sprite drawing code did, with and
+ * without SSE2, for lines of every length up to a few blocks and at unaligned addresses.
+ */
+class SpriteBlitTest : public testing::TestWithParam<bool>
+{
+protected:
+    static constexpr size_t MaxLength = 80;
+    static constexpr size_t MaxOffset = 16;
+
+    std::mt19937 _random { 1 };
+    std::vector<uint8> _palette;
+
+    void SetUp() override
+    {
+        // Without SSE2 support both runs check the plain kernels
+        SpriteBlit::UseSse2(GetParam());
+
+        // Remap palettes keep 0 as 0, but make some other colours transparent as well
+        _palette.resize(256);
+        for (size_t i = 0; i < _palette.size(); i++)
+        {
+            _palette[i] = (i % 7 == 3) ? 0 : (uint8)(i ^ 0x5A);
+        }
+        _palette[0] = 0;
+    }
+
+    void TearDown() override
+    {
+        SpriteBlit::UseSse2(true);
+    }
+
+    /**
+     * Sprite pixels with runs of transparent pixels of various lengths, so all kinds of blocks are covered.
+     */
+    std::vector<uint8> RandomSprite(size_t length)
+    {
+        std::vector<uint8> pixels(length);
+        size_t i = 0;
+        while (i < length)
+        {
+            bool transparent = (_random() % 2) == 0;
+            size_t runLength = _random() % 40;
+            for (; runLength > 0 && i < length; runLength--, i++)
+            {
+                pixels[i] = transparent ? 0 : (uint8)(1 + _random() % 255);
+            }
+        }
+        return pixels;
+    }
+
+    std::vector<uint8> RandomPixels(size_t length)
+    {
+        std::vector<uint8> pixels(length);
+        for (auto &pixel : pixels)
+        {
+            pixel = (uint8)_random();
+        }
+        return pixels;
+    }
+
+    template<typename TKernel, typename TReference>
+    void Check(TKernel kernel, TReference reference)
+    {
+        for (size_t offset = 0; offset < MaxOffset; offset++)
+        {
+            for (size_t length = 0; length <= MaxLength; length++)
+            {
+                auto src = RandomSprite(offset + length);
+                auto dst = RandomPixels(offset + length + MaxOffset);
+                auto expected = dst;
+
+                reference(&expected[offset], &src[offset], length);
+                kernel(&dst[offset], &src[offset], length);
+                ASSERT_EQ(expected, dst) << "offset " << offset << ", length " << length;
+            }
+        }
+    }
+};
+
+INSTANTIATE_TEST_CASE_P(Sse2, SpriteBlitTest, testing::Values(false, true));
+
+TEST_P(SpriteBlitTest, CopyMasked)
+{
+    Check(
+        [](uint8 * dst, const uint8 * src, size_t count) { SpriteBlit::CopyMasked(dst, src, count); },
+        [](uint8 * dst, const uint8 * src, size_t count)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                uint8 pixel = src[i];
+                if (pixel)
+                {
+                    dst[i] = pixel;
+                }
+            }
+        });
+}
+
+TEST_P(SpriteBlitTest, CopyRemapMasked)
+{
+    const uint8 * palette = _palette.data();
+    Check(
+        [palette](uint8 * dst, const uint8 * src, size_t count) { SpriteBlit::CopyRemapMasked(dst, src, palette, count); },
+        [palette](uint8 * dst, const uint8 * src, size_t count)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                uint8 pixel = palette[src[i]];
+                if (pixel)
+                {
+                    dst[i] = pixel;
+                }
+            }
+        });
+}
+
+TEST_P(SpriteBlitTest, CopyRemap)
+{
+    const uint8 * palette = _palette.data();
+    Check(
+        [palette](uint8 * dst, const uint8 * src, size_t count) { SpriteBlit::CopyRemap(dst, src, palette, count); },
+        [palette](uint8 * dst, const uint8 * src, size_t count)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                dst[i] = palette[src[i]];
+            }
+        });
+}
+
+TEST_P(SpriteBlitTest, RepaletteMasked)
+{
+    const uint8 * palette = _palette.data();
+    Check(
+        [palette](uint8 * dst, const uint8 * src, size_t count) { SpriteBlit::RepaletteMasked(dst, src, palette, count); },
+        [palette](uint8 * dst, const uint8 * src, size_t count)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                if (src[i])
+                {
+                    dst[i] = palette[dst[i]];
+                }
+            }
+        });
+}
+
+TEST_P(SpriteBlitTest, Repalette)
+{
+    const uint8 * palette = _palette.data();
+    Check(
+        [palette](uint8 * dst, const uint8 *, size_t count) { SpriteBlit::Repalette(dst, palette, count); },
+        [palette](uint8 * dst, const uint8 *, size_t count)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                dst[i] = palette[dst[i]];
+            }
+        });
+}
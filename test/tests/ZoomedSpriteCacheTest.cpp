@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include <openrct2/drawing/ZoomedSpriteCache.h>
+
+/**
+ * Checks that drawing the zoomed out copies gives the same pixels as sampling the full size sprite, for random sprites
+ * and clip rectangles, every image type and every zoom level, and that invalidated images are made again.
+ */
+class ZoomedSpriteCacheTest : public testing::Test
+{
+protected:
+    static constexpr sint32 DestWidth = 512;
+
+    std::mt19937 _random { 1 };
+    std::vector<uint8> _palette;
+
+    void SetUp() override
+    {
+        // Transparent remaps look up a pair of colours
+        _palette.resize(0x10000);
+        for (size_t i = 0; i < _palette.size(); i++)
+        {
+            _palette[i] = (i % 7 == 3) ? 0 : (uint8)((i >> 8) ^ i ^ 0x5A);
+        }
+        ZoomedSpriteCache::Clear();
+    }
+
+    void TearDown() override
+    {
+        ZoomedSpriteCache::Clear();
+    }
+
+    /**
+     * An RLE sprite with runs of random length at random places, including empty lines.
+     */
+    std::vector<uint8> RandomSprite(sint32 width, sint32 height)
+    {
+        std::vector<uint8> data(height * sizeof(uint16));
+        for (sint32 y = 0; y < height; y++)
+        {
+            data[y * 2 + 0] = (uint8)(data.size() & 0xFF);
+            data[y * 2 + 1] = (uint8)(data.size() >> 8);
+
+            size_t lastRun = SIZE_MAX;
+            sint32 x = _random() % 8;
+            while (x < width && _random() % 8 != 0)
+            {
+                sint32 length = std::min<sint32>(1 + _random() % 40, width - x);
+                lastRun = data.size();
+                data.push_back((uint8)length);
+                data.push_back((uint8)x);
+                for (sint32 i = 0; i < length; i++)
+                {
+                    data.push_back((uint8)(1 + _random() % 255));
+                }
+                x += length + _random() % 12;
+            }
+            if (lastRun == SIZE_MAX)
+            {
+                data.push_back(0x80);
+                data.push_back(0);
+            }
+            else
+            {
+                data[lastRun] |= 0x80;
+            }
+        }
+        return data;
+    }
+
+    std::vector<uint8> RandomPixels(size_t length)
+    {
+        std::vector<uint8> pixels(length);
+        for (auto &pixel : pixels)
+        {
+            pixel = (uint8)_random();
+        }
+        return pixels;
+    }
+
+    static rct_g1_element GetElement(std::vector<uint8> &data, sint32 width, sint32 height)
+    {
+        rct_g1_element g1 = { 0 };
+        g1.offset = data.data();
+        g1.width = width;
+        g1.height = height;
+        g1.flags = G1_FLAG_RLE_COMPRESSION;
+        return g1;
+    }
+
+    /**
+     * Draws part of the sprite both ways, starting at a column the zoomed out copy can be used for.
+     */
+    void CheckDraw(uint32 image, const rct_g1_element &g1, sint32 zoomLevel, sint32 imageType)
+    {
+        sint32 zoomAmount = 1 << zoomLevel;
+        sint32 sourceY = _random() % g1.height;
+        sint32 height = 1 + _random() % (g1.height - sourceY);
+        sint32 sourceX = (_random() % g1.width) & ~(zoomAmount - 1);
+        sint32 width = 1 + _random() % (g1.width - sourceX);
+
+        rct_drawpixelinfo dpi = { 0 };
+        dpi.width = DestWidth;
+        dpi.height = g1.height;
+        dpi.zoom_level = zoomLevel;
+        auto expected = RandomPixels((DestWidth >> zoomLevel) * ((g1.height >> zoomLevel) + 1));
+        auto actual = expected;
+
+        auto sprite = ZoomedSpriteCache::Get(image, &g1, zoomLevel);
+        ASSERT_NE(sprite, nullptr);
+
+        dpi.bits = expected.data();
+        gfx_rle_sprite_to_buffer(g1.offset, expected.data(), _palette.data(), &dpi, imageType, sourceY, height, sourceX, width);
+        dpi.bits = actual.data();
+        gfx_zoomed_rle_sprite_to_buffer(sprite->data(), actual.data(), _palette.data(), &dpi, imageType, sourceY, height, sourceX, width);
+        ASSERT_EQ(expected, actual) << "zoom " << zoomLevel << ", type " << std::hex << imageType << std::dec
+                                    << ", x " << sourceX << ", y " << sourceY << ", " << width << "x" << height;
+    }
+};
+
+TEST_F(ZoomedSpriteCacheTest, draws_same_pixels_as_full_size_sprite)
+{
+    const sint32 imageTypes[] = {
+        IMAGE_TYPE_DEFAULT,
+        IMAGE_TYPE_REMAP,
+        IMAGE_TYPE_TRANSPARENT,
+        IMAGE_TYPE_REMAP | IMAGE_TYPE_TRANSPARENT,
+    };
+    for (uint32 image = 0; image < 64; image++)
+    {
+        sint32 width = 1 + _random() % 250;
+        sint32 height = 1 + _random() % 100;
+        auto data = RandomSprite(width, height);
+        auto g1 = GetElement(data, width, height);
+        for (sint32 zoomLevel = 1; zoomLevel <= 3; zoomLevel++)
+        {
+            for (sint32 imageType : imageTypes)
+            {
+                for (sint32 i = 0; i < 8; i++)
+                {
+                    CheckDraw(image, g1, zoomLevel, imageType);
+                }
+            }
+        }
+    }
+}
+
+TEST_F(ZoomedSpriteCacheTest, invalidate_drops_replaced_images)
+{
+    std::vector<uint8> data;
+    data.reserve(0x10000);
+    auto original = RandomSprite(64, 32);
+    data.assign(original.begin(), original.end());
+    auto g1 = GetElement(data, 64, 32);
+    auto sprite = ZoomedSpriteCache::Get(100, &g1, 1);
+    ASSERT_NE(sprite, nullptr);
+    EXPECT_EQ(ZoomedSpriteCache::Get(100, &g1, 1), sprite);
+
+    // An object can be loaded into the image ids of a freed one with its data at the same address
+    auto replacement = RandomSprite(64, 32);
+    data.assign(replacement.begin(), replacement.end());
+    ASSERT_EQ(data.data(), g1.offset);
+    ZoomedSpriteCache::Invalidate(99, 2);
+    auto replacedSprite = ZoomedSpriteCache::Get(100, &g1, 1);
+    ASSERT_NE(replacedSprite, nullptr);
+    EXPECT_NE(replacedSprite, sprite);
+    CheckDraw(100, g1, 1, IMAGE_TYPE_DEFAULT);
+}
@@ -1,5 +1,10 @@
 // Make MSVC shut up about M_PI
 #include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
 
 #include "openrct2/util/sawyercoding.h"
 
@@ -36,6 +41,56 @@ protected:
         delete[] encodedDataBuffer;
     }
 
+    /**
+     * Creates data that looks like a park, with runs of equal bytes, repeats of recent bytes and noise in between.
+     */
+    static std::vector<uint8> create_park_like_data(size_t size)
+    {
+        std::mt19937 random(1234);
+        std::vector<uint8> data(size);
+        size_t i = 0;
+        while (i < size)
+        {
+            size_t length = std::min<size_t>(1 + random() % 200, size - i);
+            switch (random() % 3)
+            {
+            case 0:
+                std::fill(data.begin() + i, data.begin() + i + length, (uint8)(random() % 4));
+                break;
+            case 1:
+                for (size_t j = 0; j < length; j++)
+                {
+                    data[i + j] = i + j >= 16 ? data[i + j - 1 - random() % 16] : (uint8)random();
+                }
+                break;
+            default:
+                for (size_t j = 0; j < length; j++)
+                {
+                    data[i + j] = (uint8)random();
+                }
+                break;
+            }
+            i += length;
+        }
+        return data;
+    }
+
+    void test_encode_decode_data(uint8 encoding_type, const std::vector<uint8> &data)
+    {
+        sawyercoding_chunk_header chdr_in, chdr_out;
+        chdr_in.encoding = encoding_type;
+        chdr_in.length   = (uint32)data.size();
+        std::vector<uint8> encodedData(BUFFER_SIZE);
+        size_t encodedDataSize = sawyercoding_write_chunk_buffer(encodedData.data(), data.data(), chdr_in);
+        ASSERT_GT(encodedDataSize, sizeof(sawyercoding_chunk_header));
+        memcpy(&chdr_out, encodedData.data(), sizeof(sawyercoding_chunk_header));
+        std::vector<uint8> decodedData(BUFFER_SIZE);
+        size_t decodedDataSize = sawyercoding_read_chunk_buffer(
+            decodedData.data(), encodedData.data() + sizeof(sawyercoding_chunk_header), chdr_out, BUFFER_SIZE);
+        ASSERT_EQ(decodedDataSize, data.size());
+        ASSERT_EQ(memcmp(decodedData.data(), data.data(), data.size()), 0);
+    }
+
     void test_decode(const uint8 * data, size_t size)
     {
         sawyercoding_chunk_header chdr_in;
@@ -71,6 +126,46 @@ TEST_F(SawyerCodingTest, write_read_chunk_rotate)
     test_encode_decode(CHUNK_ENCODING_ROTATE);
 }
 
+TEST_F(SawyerCodingTest, write_read_chunk_rle_park_like)
+{
+    test_encode_decode_data(CHUNK_ENCODING_RLE, create_park_like_data(0x10000));
+}
+
+TEST_F(SawyerCodingTest, write_read_chunk_rle_compressed_park_like)
+{
+    test_encode_decode_data(CHUNK_ENCODING_RLECOMPRESSED, create_park_like_data(0x10000));
+}
+
+TEST_F(SawyerCodingTest, write_read_chunk_short)
+{
+    // The ends of the buffers are encoded without reading whole words
+    for (size_t size = 1; size < 40; size++)
+    {
+        test_encode_decode_data(CHUNK_ENCODING_RLE, create_park_like_data(size));
+        test_encode_decode_data(CHUNK_ENCODING_RLECOMPRESSED, create_park_like_data(size));
+        test_encode_decode_data(CHUNK_ENCODING_ROTATE, create_park_like_data(size));
+    }
+}
+
+TEST_F(SawyerCodingTest, encode_throughput)
+{
+    // As large as the map elements chunk of a saved park
+    std::vector<uint8> data = create_park_like_data(0x180000);
+    sawyercoding_chunk_header chdr_in;
+    chdr_in.encoding = CHUNK_ENCODING_RLECOMPRESSED;
+    chdr_in.length   = (uint32)data.size();
+    std::vector<uint8> encodedData(BUFFER_SIZE);
+
+    auto startTime = std::chrono::steady_clock::now();
+    size_t encodedDataSize = sawyercoding_write_chunk_buffer(encodedData.data(), data.data(), chdr_in);
+    auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    ASSERT_GT(encodedDataSize, sizeof(sawyercoding_chunk_header));
+    printf("Encoded %u bytes to %u bytes in %.1f ms (%.1f MiB/s)\n", (uint32)data.size(), (uint32)encodedDataSize,
+           duration * 1000, data.size() / (1024.0 * 1024.0) / std::max(duration, 1e-9));
+
+    test_encode_decode_data(CHUNK_ENCODING_RLECOMPRESSED, data);
+}
+
 // Note we only check if provided data decompresses to the same data, not if it compresses the same.
 // The reason for that is we may improve encoding at some point, but the test won't be affected,
 // as we already do a decode test and rountrip (encode + decode), which validates all uses.